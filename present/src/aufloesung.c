@@ -50,6 +50,16 @@ char *urbildGBFile(resol_t *resol, long n)
   return buffer;
 }
 
+/******************************************************************************/
+char *checkpointFile(resol_t *resol, long n)
+/* String returned must be used at once, never reused, never freed. */
+/* Represents an unfinished computation of d_n : P_n -> P_{n-1} */
+{
+  static char buffer[MAXLINE];
+  sprintf(buffer, "%sd%02ld.ckp", resol->stem, n);
+  return buffer;
+}
+
 /******************************************************************************/
 char *resolDir(long Gsize)
 /* String returned must be used at once, never reused, never freed. */
@@ -346,6 +356,37 @@ nRgs_t *nRgsStandardSetup(resol_t *resol, long n, PTR mat)
   return nRgs;
 }
 
+/****
+ * NULL on error
+ ***************************************************************************/
+nRgs_t *nRgsCheckpointSetup(resol_t *resol, long n, char *file)
+/* As nRgsStandardSetup, but the vectors are restored from a checkpoint
+ * that was saved by nRgsBuchberger */
+{
+  char thisStem[MAXLINE];
+  group_t *group = resol->group;
+  long r = rankProj(resol, n-1);
+  if (r==-1) return NULL;
+  long s = rankProj(resol, n);
+  if (s==-1) return NULL;
+  nRgs_t *nRgs;
+  sprintf(thisStem, "%sd%ld", resol->stem, n);
+  nRgs = nRgsAllocation(group, r, s, thisStem);
+  if (!nRgs) return NULL;
+  nRgs->ngs->targetRank = dimIm(resol, n);
+  nRgs->ker->ngs->targetRank = dimIm(resol, n+1);
+  if (nRgs->ngs->targetRank == -1 || nRgs->ker->ngs->targetRank == -1)
+  { freeNRgs(nRgs);
+    MTX_ERROR("targetRank == -1: Theoretical error");
+    return NULL;
+  }
+  if (restoreNRgsCheckpoint(nRgs, group, file))
+  { freeNRgs(nRgs);
+    return NULL;
+  }
+  return nRgs;
+}
+
 /******************************************************************************/
 static char dateCommand[LONGLINE];
 
@@ -409,7 +450,7 @@ Matrix_t *makeFirstDifferential(resol_t *resol)
 nRgs_t *loadDifferential(resol_t *resol, long n)
 {
   nRgs_t *nRgs;
-  Matrix_t *pres = MatLoad(differentialFile(resol, n));
+  Matrix_t *pres = mappedMatLoad(differentialFile(resol, n));
   if (!pres)
   { MTX_ERROR1("%E", MTX_ERR_NOMEM);
     return NULL;
@@ -425,7 +466,7 @@ nRgs_t *loadDifferential(resol_t *resol, long n)
 nRgs_t *loadUrbildGroebnerBasis(resol_t *resol, long n)
 {
   nRgs_t *nRgs;
-  Matrix_t *pres = MatLoad(urbildGBFile(resol, n));
+  Matrix_t *pres = mappedMatLoad(urbildGBFile(resol, n));
   if (!pres)
   { MTX_ERROR1("%E", MTX_ERR_NOMEM);
     return NULL;
@@ -481,7 +522,7 @@ int innerPreimages(nRgs_t *nRgs, PTR images, long num, group_t *group,
     gv = popGeneralVector(ngs);
     if (!gv) return 1;
     tmp = gv->w;
-    gv->w = FfGetPtr(images, i * ngs->r);
+    gv->w = rowPtr(&ngs->fc, images, i * ngs->r);
     findLeadingMonomial(gv, ngs->r, group);
     gv->w = tmp;
     if (gv->dim == ZERO_BLOCK)
@@ -491,10 +532,10 @@ int innerPreimages(nRgs_t *nRgs, PTR images, long num, group_t *group,
     }
     else
     {
-      memcpy(gv->w, FfGetPtr(images, i * ngs->r), (FfCurrentRowSize*ngs->r));
+      memcpy(gv->w, rowPtr(&ngs->fc, images, i * ngs->r), (ngs->fc.rowSize*ngs->r));
       /* That gv->w is initialized is very likely, but not absolutely certain */
       /*initializeRows(FfGetPtr(gv->w, ngs->r), ngs->s);*/
-      memset(FfGetPtr(gv->w, ngs->r), 0, FfCurrentRowSize*ngs->s);
+      memset(rowPtr(&ngs->fc, gv->w, ngs->r), 0, ngs->fc.rowSize*ngs->s);
       uv = unreducedVector(ngs, gv);
       if (!uv) return 1;
       uv->index = i;
@@ -29,6 +29,8 @@
 #include "meataxe.h"
 #include "aufnahme.h"
 
+typedef unsigned char BYTE;
+
 MTX_DEFINE_FILE_INFO
 
 /******************************************************************************/
@@ -37,33 +39,99 @@ static modW_t *wordForestEntry(ngs_t *ngs, gV_t *gv)
   return ngs->proot[gv->block] + (gv->col);
 }
 
+/******************************************************************************
+ * Kernels for the r+s rows of a gV_t, which are contiguous in memory.
+ * Over GF(2), a subtraction is one wide XOR over the whole block. Over the
+ * other fields, the byte tables of the MeatAxe are applied to the whole
+ * block, skipping zero bytes of the source; the padding at the end of
+ * each row is zero and remains zero.
+ */
+static void xorBlock(PTR dest, PTR src, size_t bytes)
+{
+  register size_t n = bytes / sizeof(long);
+  register size_t k;
+  xorLongs((long *) dest, (const long *) src, (long) n);
+  for (k = n * sizeof(long); k < bytes; k++) dest[k] ^= src[k];
+}
+
 /******************************************************************************/
-static void subtract(PTR ptr1, PTR ptr2, long nor)
-/* writes ptr1 - ptr2 to ptr1 */
+static void addMulBlockGF2(PTR dest, PTR src, FEL f, size_t bytes)
 {
-  register long i;
-  register PTR p1 = ptr1, p2 = ptr2;
-  for (i = 0; i < nor; i++, p1+=FfCurrentRowSize, p2+=FfCurrentRowSize)
+  if (f != FF_ZERO) xorBlock(dest, src, bytes);
+}
+
+/******************************************************************************/
+static void mulBlockGF2(PTR dest, FEL f, size_t bytes)
+{
+  if (f == FF_ZERO) memset(dest, 0, bytes);
+}
+
+/******************************************************************************/
+static void addMulBlockTable(PTR dest, PTR src, FEL f, size_t bytes)
+{
+  register BYTE *r = (BYTE *) dest;
+  register BYTE *v = (BYTE *) src;
+  register BYTE *end = v + bytes;
+  if (f == FF_ZERO) return;
+  if (f == FF_ONE)
   {
-    FfSubRow(p1,p2);
-    /*FfStepPtr(&p1); FfStepPtr(&p2);*/
+    for (; v != end; ++v, ++r)
+      if (*v) *r = mtx_tadd[*r][*v];
+  }
+  else
+  {
+    register BYTE *multab = mtx_tmult[f];
+    for (; v != end; ++v, ++r)
+      if (*v) *r = mtx_tadd[*r][multab[*v]];
   }
-  return;
 }
 
 /******************************************************************************/
-static void submul(PTR ptr1, PTR ptr2, FEL f, long nor)
-/* writes ptr1 - f.ptr2 to ptr1 */
+static void subBlockTable(PTR dest, PTR src, size_t bytes)
 {
-  register long i;
-  register FEL g = FfNeg(f);
-  PTR p1 = ptr1, p2 = ptr2;
-  for (i = 0; i < nor; i++, p1+=FfCurrentRowSize, p2+=FfCurrentRowSize)
+  addMulBlockTable(dest, src, FfNeg(FF_ONE), bytes);
+}
+
+/******************************************************************************/
+static void mulBlockTable(PTR dest, FEL f, size_t bytes)
+{
+  register BYTE *r = (BYTE *) dest;
+  register BYTE *end = r + bytes;
+  register BYTE *multab = mtx_tmult[f];
+  for (; r != end; ++r)
+    if (*r) *r = multab[*r];
+}
+
+/******************************************************************************/
+void selectBlockKernels(ngs_t *ngs)
+/* Once per ngs: the kernels only depend on the field */
+{
+  if (ngs->fc.fl == 2)
   {
-    FfAddMulRow(p1,p2, g);
-    /*FfStepPtr(&p1); FfStepPtr(&p2);*/
+    ngs->subBlock = xorBlock;
+    ngs->addMulBlock = addMulBlockGF2;
+    ngs->mulBlock = mulBlockGF2;
   }
-  return;
+  else
+  {
+    ngs->subBlock = subBlockTable;
+    ngs->addMulBlock = addMulBlockTable;
+    ngs->mulBlock = mulBlockTable;
+  }
+}
+
+/******************************************************************************/
+static inline void subtract(ngs_t *ngs, PTR ptr1, PTR ptr2, long nor)
+/* writes ptr1 - ptr2 to ptr1 */
+{
+  ngs->subBlock(ptr1, ptr2, nor * ngs->fc.rowSize);
+}
+
+/******************************************************************************/
+static inline void submul(ngs_t *ngs, PTR ptr1, PTR ptr2, FEL f, long nor)
+/* writes ptr1 - f.ptr2 to ptr1 */
+{
+  ngs->addMulBlock(ptr1, ptr2, FfNeg(f), nor * ngs->fc.rowSize);
 }
 
 /****
@@ -72,6 +140,7 @@ static void submul(PTR ptr1, PTR ptr2, FEL f, long nor)
 static int demoteReducedVector(ngs_t *ngs, rV_t *rv)
 /* rv used to be reduced, but we've just found something it reduces over */
 {
+  ngs->stats.demotions++;
   unlinkReducedVector(ngs, rv);
   if (insertNewUnreducedVector(ngs, rv->gv)) return 1;
   rv->gv = NULL;
@@ -83,11 +152,17 @@ static int demoteReducedVector(ngs_t *ngs, rV_t *rv)
  * 1 on error
  *************************************************************************/
 static int markNodeMultiples(ngs_t *ngs, rV_t *rv, modW_t *node,
-  boolean alreadyFound, path_t *ext, group_t *group)
+  boolean alreadyFound, long ext, group_t *group)
 {
   /* node != NULL guaranteed */
-  /* know: node represents tip(rv) * ext */
+  /* know: node represents tip(rv) * ext, ext being the index of a nontip */
   register long a;
+  long arrows = group->arrows;
+  long pat = (node - ngs->proot[0]) % group->nontips;
+  modW_t *row = node - pat;
+  const int32_t *kids = group->pathChild + pat * arrows;
+  const int32_t *extkids = group->pathChild + ext * arrows;
+  wordState_t *ws = wordState(ngs, node);
   rV_t *v = node->divisor;
   boolean aF = alreadyFound;
   if (!alreadyFound && v != NULL)
@@ -97,19 +172,35 @@ static int markNodeMultiples(ngs_t *ngs, rV_t *rv, modW_t *node,
     aF = true;
   }
   node->divisor = rv;
-  node->qi = ext->index;
-  node->status = (ext->index == 0) ? SCALAR_MULTIPLE : NONSCALAR_MULTIPLE;
-  if (ext->index == 0) node->parent = NULL;
+  ws->qi = ext;
+  ws->status = (ext == 0) ? SCALAR_MULTIPLE : NONSCALAR_MULTIPLE;
+  if (ext == 0) node->parent = NULL;
   if (!aF) ngs->pnontips--;
-  for (a = 0; a < group->arrows; a++)
+  for (a = 0; a < arrows; a++)
   {
-    if (!node->child[a]) continue;
-    node->child[a]->parent = node;
-    if (markNodeMultiples(ngs, rv, node->child[a], aF, ext->child[a], group)) return 1;
+    if (kids[a] < 0) continue;
+    row[kids[a]].parent = node;
+    if (markNodeMultiples(ngs, rv, row + kids[a], aF, extkids[a], group)) return 1;
   }
   return 0;
 }
 
+/*****
+ * NULL on error
+ **************************************************************************/
+rV_t *ngsAssertReducedVector(ngs_t *ngs, gV_t *gv, group_t *group)
+/* The leading monomial of gv must be known, and gv must not be reducible
+ * by the reduced vectors of ngs */
+{
+  modW_t *ptn = wordForestEntry(ngs, gv);
+  rV_t *rv = reducedVector(ngs, gv, group);
+  if (!rv) return NULL;
+  rv->node = ptn;
+  if (insertReducedVector(ngs, rv)) return NULL;
+  if (markNodeMultiples(ngs, rv, ptn, false, 0, group)) return NULL;
+  return rv;
+}
+
 /*****
  * 1 on error
  **************************************************************************/
@@ -118,22 +209,15 @@ int nRgsAssertReducedVectors(nRgs_t *nRgs, PTR mat, long num, group_t *group)
 {
   ngs_t *ngs = nRgs->ngs;
   register gV_t *gv;
-  register rV_t *rv;
-  modW_t *ptn;
   register long i;
   long nor = ngs->r + ngs->s;
   for (i = 0; i < num; i++)
   {
     gv = popGeneralVector(ngs);
     if (!gv) return 1;
-    memcpy(gv->w, FfGetPtr(mat, i * nor), (FfCurrentRowSize*nor));
+    memcpy(gv->w, rowPtr(&ngs->fc, mat, i * nor), (ngs->fc.rowSize*nor));
     findLeadingMonomial(gv, ngs->r, group);
-    ptn = wordForestEntry(ngs, gv);
-    rv = reducedVector(gv, group);
-    if (!rv) return 1;
-    rv->node = ptn;
-    if (insertReducedVector(ngs, rv)) return 1;
-    if (markNodeMultiples(ngs, rv, ptn, false, group->root, group)) return 1;
+    if (!ngsAssertReducedVector(ngs, gv, group)) return 1;
   }
   if (ngs->unreducedHeap)
   { MTX_ERROR("nRgsAssertRV: Theoretical error");
@@ -149,13 +233,14 @@ static int promoteUnreducedVector(ngs_t *ngs, uV_t *uv, group_t *group)
 {
   modW_t *ptn = wordForestEntry(ngs, uv->gv);
   rV_t *rv;
-  rv = reducedVector(uv->gv, group);
+  ngs->stats.promotions++;
+  rv = reducedVector(ngs, uv->gv, group);
   if (!rv) return 1;
   rv->node = ptn;
   uv->gv = NULL;
-  freeUnreducedVector(uv);
+  freeUnreducedVector(ngs, uv);
   if (insertReducedVector(ngs, rv)) return 1;
-  return markNodeMultiples(ngs, rv, ptn, false, group->root, group);
+  return markNodeMultiples(ngs, rv, ptn, false, 0, group);
 }
 
 /******************************************************************************/
@@ -177,7 +262,7 @@ static int nFgsProcessModifiedUnreducedVector(nFgs_t *nFgs, uV_t *uv,
   gV_t *gv = uv->gv;
   findLeadingMonomial(gv, ngs->r, group);
   if (gv->dim == ZERO_BLOCK)
-    freeUnreducedVector(uv);
+    freeUnreducedVector(ngs, uv);
   else
   {
     if (makeVectorMonic(ngs, gv)) return 1;
@@ -197,7 +282,7 @@ static int nRgsProcessModifiedUnreducedVector(nRgs_t *nRgs, uV_t *uv, group_t *g
   if (gv->dim == ZERO_BLOCK)
   {
     possiblyNewKernelGenerator(nRgs, gv->w, group);
-    freeUnreducedVector(uv);
+    freeUnreducedVector(ngs, uv);
   }
   else
   {
@@ -221,10 +306,10 @@ static int urbildProcessModifiedUnreducedVector(nRgs_t *nRgs, uV_t *uv,
   findLeadingMonomial(gv, r, group);
   if (gv->dim == ZERO_BLOCK)
   {
-    src = FfGetPtr(gv->w, r);
-    dest = FfGetPtr(result, uv->index * s);
-    memcpy(dest, src, (FfCurrentRowSize*s));
-    freeUnreducedVector(uv);
+    src = rowPtr(&ngs->fc, gv->w, r);
+    dest = rowPtr(&ngs->fc, result, uv->index * s);
+    memcpy(dest, src, (ngs->fc.rowSize*s));
+    freeUnreducedVector(ngs, uv);
   }
   else insertUnreducedVector(ngs, uv);
   return 0;
@@ -243,7 +328,7 @@ static int nFgsPerformLinearReductions(nFgs_t *nFgs, gV_t *gv0, group_t *group)
     && gv->block == gv0->block)
   {
     unlinkUnreducedVector(ngs, uv);
-    subtract(gv->w, gv0->w,nor);
+    subtract(ngs, gv->w, gv0->w,nor);
     if (nFgsProcessModifiedUnreducedVector(nFgs, uv, group)) return 1;
   }
   return 0;
@@ -262,7 +347,7 @@ static int nRgsPerformLinearReductions(nRgs_t *nRgs, gV_t *gv0, group_t *group)
     && gv->block == gv0->block)
   {
     unlinkUnreducedVector(ngs, uv);
-    subtract(gv->w, gv0->w,nor);
+    subtract(ngs, gv->w, gv0->w,nor);
     if (nRgsProcessModifiedUnreducedVector(nRgs, uv, group)) return 1;
   }
   return 0;
@@ -274,7 +359,7 @@ static boolean shouldReduceTip(ngs_t *ngs, gV_t *gv)
 {
   modW_t *node = wordForestEntry(ngs, gv) ;
   if (!node->divisor) return false;
-  if (node->qi == 0 && !node->divisor->gv->radical && gv->radical)
+  if (wordState(ngs, node)->qi == 0 && !node->divisor->gv->radical && gv->radical)
   {
     return false;
   }
@@ -292,11 +377,14 @@ static int reduceMonicTipOnce(ngs_t *ngs, gV_t *gv, group_t *group)
   modW_t *node;
   PTR w;
   long nor;
+  double t0 = STATS_CLOCK(ngs);
   node = wordForestEntry(ngs, gv);
   w = nodeVector(ngs, group, node);
   if (!w) return 1;
   nor = ngs->r + ngs->s;
-  subtract(gv->w, w, nor);
+  subtract(ngs, gv->w, w, nor);
+  ngs->stats.reductions++;
+  STATS_ADD_TIME(ngs, reduceTime, t0);
   return 0;
 }
 
@@ -311,11 +399,14 @@ static int reduceTipOnce(ngs_t *ngs, gV_t *gv, group_t *group)
   modW_t *node;
   PTR w;
   long nor;
+  double t0 = STATS_CLOCK(ngs);
   node = wordForestEntry(ngs, gv);
   w = nodeVector(ngs, group, node);
   if (!w) return 1;
   nor = ngs->r + ngs->s;
-  submul(gv->w, w, gv->coeff, nor);
+  submul(ngs, gv->w, w, gv->coeff, nor);
+  ngs->stats.reductions++;
+  STATS_ADD_TIME(ngs, reduceTime, t0);
   return 0;
 }
 
@@ -29,7 +29,9 @@
 int nFgsAufnahme(nFgs_t *nFgs, group_t *group);
 int nRgsAufnahme(nRgs_t *nRgs, group_t *group);
 int urbildAufnahme(nRgs_t *nRgs, group_t *group, PTR result);
+rV_t *ngsAssertReducedVector(ngs_t *ngs, gV_t *gv, group_t *group);
 int nRgsAssertReducedVectors(nRgs_t *nRgs, PTR mat, long num, group_t *group);
 void possiblyNewKernelGenerator(nRgs_t *nRgs, PTR pw, group_t *group);
+void selectBlockKernels(ngs_t *ngs);
 
 #endif
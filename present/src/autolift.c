@@ -0,0 +1,243 @@
+/*****************************************************************************
+       Copyright (C) 2026 agent <agent@local>
+
+    This file is part of p_group_cohomology.
+
+    p_group_cohomoloy is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    p_group_cohomoloy is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with p_group_cohomoloy.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+/*
+*  autolift.c : Linear algebra for the autolift data of a resolution
+*  Author: agent
+*
+* The autolift data in degree d are obtained from the reduced echelon form
+* of the augmented matrix
+*
+*      ( D * g_j, restricted to the i-th summand of P_d | e_{i*nt+j} )
+*
+* where d: P_d -> P_{d-1} is the differential, g_j runs over the nt
+* nontips of the group algebra, and i runs over the RK summands of P_d.
+* The rows whose pivot lies in the left part give, in their right part,
+* a preimage under d of each basis vector of the image of d.
+* Since the reduced echelon form is unique, the result coincides with
+* the result of a general purpose echelonization.
+*/
+
+#include "pcommon.h"
+#include "meataxe.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+MTX_DEFINE_FILE_INFO
+
+/* The share of the rows of the augmented matrix handled by one thread */
+typedef struct
+{
+  Matrix_t *mat;
+  Matrix_t **DG;
+  long nt, rk;
+  long first, last;     /* rows first <= x < last are handled */
+  long skipFirst, skipLast; /* except for skipFirst <= x < skipLast */
+  long *col;            /* pivot columns of the current panel, which */
+  long b;               /* consists of the b rows from skipFirst on */
+} autoliftShare_t;
+
+/******************************************************************************/
+static inline PTR matRow(Matrix_t *mat, long x)
+/* Does not depend on FfNoc, in contrast to FfGetPtr */
+{
+  return (PTR)((char *)mat->Data + x * mat->RowSize);
+}
+
+/******************************************************************************/
+static void *fillWorker(void *arg)
+/* Row i*nt+j of the augmented matrix consists of the rows i*rk,...,i*rk+rk-1
+ * of DG[j], followed by a unit vector */
+{
+  autoliftShare_t *share = (autoliftShare_t *) arg;
+  long nt = share->nt, rk = share->rk;
+  register long x, k, l;
+  register PTR dest, src;
+  for (x = share->first; x < share->last; x++)
+  {
+    long i = x / nt, j = x % nt;
+    dest = matRow(share->mat, x);
+    for (k = 0; k < rk; k++)
+    {
+      src = matRow(share->DG[j], i*rk + k);
+      for (l = 0; l < nt; l++)
+        FfInsert(dest, k*nt + l, FfExtract(src, l));
+    }
+    FfInsert(dest, rk*nt + x, FF_ONE);
+  }
+  return NULL;
+}
+
+/******************************************************************************/
+static void *eliminationWorker(void *arg)
+/* Clears the pivot columns of the current panel. The pivots of the
+ * panel rows are one, and the panel is in reduced echelon form. */
+{
+  autoliftShare_t *share = (autoliftShare_t *) arg;
+  register long x, q;
+  register PTR row;
+  FEL f;
+  for (x = share->first; x < share->last; x++)
+  {
+    if (x >= share->skipFirst && x < share->skipLast) continue;
+    row = matRow(share->mat, x);
+    for (q = 0; q < share->b; q++)
+    {
+      f = FfExtract(row, share->col[q]);
+      if (f != FF_ZERO)
+        FfAddMulRow(row, matRow(share->mat, share->skipFirst + q), FfNeg(f));
+    }
+  }
+  return NULL;
+}
+
+/******************************************************************************/
+static void runShares(void *(*worker)(void *), autoliftShare_t *share,
+  long nor, long threads)
+/* Distributes the rows 0,...,nor-1 over the threads. FfSetField and FfSetNoc
+ * must have been called. If a thread can not be started, its share is
+ * done by the master thread. */
+{
+  pthread_t tid[MAX_WORKER_THREADS];
+  int started[MAX_WORKER_THREADS];
+  register long t;
+  long chunk = (nor + threads - 1) / threads;
+  for (t = 0; t < threads; t++)
+  {
+    if (t) share[t] = share[0];
+    share[t].first = (t * chunk < nor) ? t * chunk : nor;
+    share[t].last = ((t+1) * chunk < nor) ? (t+1) * chunk : nor;
+    started[t] = 0;
+  }
+  for (t = 1; t < threads; t++)
+    started[t] = !pthread_create(tid + t, NULL, worker, share + t);
+  worker(share);
+  for (t = 1; t < threads; t++)
+  {
+    if (started[t]) pthread_join(tid[t], NULL);
+    else worker(share + t);
+  }
+  return;
+}
+
+/******************************************************************************/
+static int comparePivots(const void *a, const void *b)
+{
+  long x = ((const long *) a)[0], y = ((const long *) b)[0];
+  return (x > y) - (x < y);
+}
+
+/*****
+ * NULL on error
+ **************************************************************************/
+Matrix_t *autoliftPreimages(Matrix_t **DG, long nt, long rk, long RK,
+  long threads, long *pivots, long *npiv)
+/* DG[j] is the product of the differential (RK*rk rows, nt columns) with
+ * the action of the j-th nontip. On output, pivots[0],...,pivots[*npiv-1]
+ * are the pivots of the image of the differential (pivots must provide
+ * space for RK*nt entries), and the returned matrix consists of *npiv
+ * blocks of RK rows and nt columns: The k-th block is a preimage of the
+ * row of the echelon form with pivot pivots[k]. */
+{
+  long nor = RK * nt, rknt = rk * nt;
+  long r = 0, next = 0, b, q, c;
+  autoliftShare_t share[MAX_WORKER_THREADS];
+  long *col;
+  long (*found)[2];
+  register PTR x;
+  FEL f, g;
+  Matrix_t *mat, *out;
+  if (threads < 1) threads = 1;
+  if (threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+  if (threads > nor) threads = (nor > 0) ? nor : 1;
+  mat = MatAlloc(DG[0]->Field, nor, rknt + nor);
+  if (!mat) return NULL;
+  col = (long *) malloc(AUTOLIFT_PANEL * sizeof(long));
+  found = malloc(nor * sizeof(*found));
+  if (!col || !found)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    free(col); free(found); MatFree(mat);
+    return NULL;
+  }
+  FfSetField(mat->Field);
+  FfSetNoc(mat->Noc);
+  share[0].mat = mat;
+  share[0].DG = DG;
+  share[0].nt = nt;
+  share[0].rk = rk;
+  share[0].col = col;
+  runShares(fillWorker, share, nor, threads);
+
+  /* Rows below r are pivot rows, rows from r to next-1 are zero,
+   * and rows from next on are not yet considered. */
+  while (next < nor)
+  {
+    for (b = 0; b < AUTOLIFT_PANEL && next < nor; next++)
+    {
+      x = matRow(mat, next);
+      for (q = 0; q < b; q++)
+      {
+        f = FfExtract(x, col[q]);
+        if (f != FF_ZERO) FfAddMulRow(x, matRow(mat, r+q), FfNeg(f));
+      }
+      c = FfFindPivot(x, &f);
+      if (c < 0) continue;
+      FfMulRow(x, FfInv(f));
+      for (q = 0; q < b; q++)
+      {
+        g = FfExtract(matRow(mat, r+q), c);
+        if (g != FF_ZERO) FfAddMulRow(matRow(mat, r+q), x, FfNeg(g));
+      }
+      if (next != r+b) FfSwapRows(matRow(mat, r+b), x);
+      col[b++] = c;
+    }
+    share[0].skipFirst = r;
+    share[0].skipLast = next;
+    share[0].b = b;
+    if (b) runShares(eliminationWorker, share, nor, threads);
+    for (q = 0; q < b; q++)
+    { found[r+q][0] = col[q];
+      found[r+q][1] = r+q;
+    }
+    r += b;
+  }
+  free(col);
+
+  /* The preimages, sorted by pivots */
+  qsort(found, r, sizeof(*found), comparePivots);
+  for (*npiv = 0; *npiv < r && found[*npiv][0] < rknt; (*npiv)++)
+    pivots[*npiv] = found[*npiv][0];
+  out = MatAlloc(mat->Field, (*npiv) * RK, nt);
+  if (!out)
+  { free(found); MatFree(mat);
+    return NULL;
+  }
+  for (q = 0; q < *npiv; q++)
+  {
+    register long k, l;
+    x = matRow(mat, found[q][1]);
+    for (k = 0; k < RK; k++)
+    { PTR dest = matRow(out, q*RK + k);
+      for (l = 0; l < nt; l++)
+        FfInsert(dest, l, FfExtract(x, rknt + k*nt + l));
+    }
+  }
+  free(found);
+  MatFree(mat);
+  return out;
+}
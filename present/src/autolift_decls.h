@@ -0,0 +1,30 @@
+/*****************************************************************************
+       Copyright (C) 2026 agent <agent@local>
+
+    This file is part of p_group_cohomology.
+
+    p_group_cohomoloy is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    p_group_cohomoloy is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with p_group_cohomoloy.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+/* This is C code
+*  autolift_decls.h : Header file listing declarations in autolift.c
+*  Author: agent
+*/
+
+#if !defined(__AUTOLIFT_DECLS_INCLUDED)    /* Include only once */
+#define __AUTOLIFT_DECLS_INCLUDED
+
+Matrix_t *autoliftPreimages(Matrix_t **DG, long nt, long rk, long RK,
+  long threads, long *pivots, long *npiv);
+
+#endif
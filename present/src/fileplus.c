@@ -25,7 +25,14 @@
 */
 
 #include "fileplus.h"
+#include "fp_decls.h"
 #include "meataxe.h"
+#include <zlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 MTX_DEFINE_FILE_INFO
 
@@ -122,12 +129,52 @@ FILE *writehdrplus(char *name, long fl, long nor, long noc)
   return fp;
 }
 
+/**
+ * NULL on error
+ ****/
+static FILE *expandedCopy(char *name, long *fl, long *nor, long *noc)
+/* A temporary dense copy of a matrix file, positioned after the header */
+{
+  FILE *fp;
+  long header[3];
+  Matrix_t *mat = mappedMatLoad(name);
+  if (!mat) return NULL;
+  header[0] = mat->Field;
+  header[1] = mat->Nor;
+  header[2] = mat->Noc;
+  fp = tmpfile();
+  if (!fp)
+  {
+    MatFree(mat);
+    MTX_ERROR1("Cannot create temporary copy of %s", name);
+    return NULL;
+  }
+  if (SysWriteLong(fp,header,3) != 3 ||
+      FfWriteRows(fp, mat->Data, mat->Nor) != mat->Nor || SysFseek(fp,(long)12))
+  {
+    MatFree(mat);
+    fclose(fp);
+    MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return NULL;
+  }
+  MatFree(mat);
+  if (fl != NULL)
+    *fl = header[0];
+  if (nor != NULL)
+    *nor = header[1];
+  if (noc != NULL)
+    *noc = header[2];
+  return fp;
+}
+
 /**
  * NULL on error
  ****/
 FILE *readhdrplus(char *name, long *fl, long *nor, long *noc)
 /* Opens existing file for read/write */
 /* Assigns to fl, nor, noc, unless NULL */
+/* A sparse or compressed file is expanded into a temporary file,
+ * so that writing to the result does not change the file */
 {
   FILE *fp;
   long header[3];
@@ -143,6 +190,11 @@ FILE *readhdrplus(char *name, long *fl, long *nor, long *noc)
     MTX_ERROR1("%E", MTX_ERR_FILEFMT);
     return NULL;
   }
+  if (header[0] == SPARSE_MATRIX_MAGIC || header[0] == COMPRESSED_MATRIX_MAGIC)
+  {
+    fclose(fp);
+    return expandedCopy(name, fl, nor, noc);
+  }
   if (fl != NULL)
     *fl = header[0];
   if (nor != NULL)
@@ -158,19 +210,505 @@ FILE *readhdrplus(char *name, long *fl, long *nor, long *noc)
   return fp;
 }
 
+/******************************************************************************/
+static long headerEntry(const unsigned char *p)
+/* MeatAxe files store the header as 32 bit little endian integers */
+{
+  return (long) (int) ((unsigned int) p[0] | ((unsigned int) p[1] << 8) |
+    ((unsigned int) p[2] << 16) | ((unsigned int) p[3] << 24));
+}
+
+/******************************************************************************/
+void unmapfileplus(mappedFile_t *mf)
+{
+  munmap(mf->base, mf->length);
+  if (mf->offset) free(mf->offset);
+  if (mf->buffer) free(mf->buffer);
+  free(mf);
+  return;
+}
+
+/**
+ * 1 on error
+ ****/
+static int mapBlockTable(mappedFile_t *mf)
+/* Reads the header of a compressed file; releases mf on error */
+{
+  long i, size;
+  const unsigned char *p = (const unsigned char *) mf->base;
+  if (mf->length < 24)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  mf->fl = headerEntry(p + 12);
+  mf->blockRows = headerEntry(p + 16);
+  mf->nblocks = headerEntry(p + 20);
+  mf->nnz = mf->nor;
+  mf->index = NULL;
+  mf->rows = NULL;
+  if (mf->nor < 0 || mf->blockRows <= 0 ||
+      mf->nblocks != (mf->nor + mf->blockRows - 1) / mf->blockRows ||
+      mf->length < 24 + 4 * (size_t) mf->nblocks)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  mf->offset = (size_t *) malloc((mf->nblocks + 1) * sizeof(size_t));
+  if (!mf->offset)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  mf->offset[0] = 24 + 4 * (size_t) mf->nblocks;
+  for (i = 0; i < mf->nblocks; i++)
+  {
+    size = headerEntry(p + 24 + 4 * i);
+    mf->offset[i+1] = mf->offset[i] + (size_t) size;
+    if (size < 0 || mf->offset[i+1] > mf->length)
+    {
+      unmapfileplus(mf);
+      MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * NULL on error
+ ****/
+mappedFile_t *mapfileplus(char *name)
+/* Read-only view of an existing file; the header is parsed only once */
+{
+  mappedFile_t *mf;
+  struct stat st;
+  void *base;
+  int fd = open(name, O_RDONLY);
+  if (fd == -1)
+  {
+    MTX_ERROR1("Cannot open file %s", name);
+    return NULL;
+  }
+  if (fstat(fd, &st) || st.st_size < 12)
+  {
+    close(fd);
+    MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+    return NULL;
+  }
+  base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    MTX_ERROR1("Cannot map file %s", name);
+    return NULL;
+  }
+  mf = (mappedFile_t *) malloc(sizeof(mappedFile_t));
+  if (!mf)
+  {
+    munmap(base, (size_t) st.st_size);
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return NULL;
+  }
+  mf->base = base;
+  mf->length = (size_t) st.st_size;
+  mf->fl = headerEntry((const unsigned char *) base);
+  mf->nor = headerEntry((const unsigned char *) base + 4);
+  mf->noc = headerEntry((const unsigned char *) base + 8);
+  mf->blockRows = 0;
+  mf->nblocks = 0;
+  mf->offset = NULL;
+  mf->buffer = NULL;
+  mf->bufferedBlock = -1;
+  if (mf->fl == COMPRESSED_MATRIX_MAGIC)
+    return (mapBlockTable(mf)) ? NULL : mf;
+  if (mf->fl != SPARSE_MATRIX_MAGIC)
+  {
+    mf->nnz = mf->nor;
+    mf->index = NULL;
+    mf->rows = (const char *) base + 12;
+    return mf;
+  }
+  if (mf->length < 20)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+    return NULL;
+  }
+  mf->fl = headerEntry((const unsigned char *) base + 12);
+  mf->nnz = headerEntry((const unsigned char *) base + 16);
+  mf->index = (const char *) base + 20;
+  if (mf->nnz < 0 || mf->nnz > mf->nor || mf->length < 20 + 4 * (size_t) mf->nnz)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+    return NULL;
+  }
+  mf->rows = mf->index + 4 * mf->nnz;
+  return mf;
+}
+
 /**
  * -1 on error
  ****/
 long numberOfRowsStored(char *name)
+/* Works for dense and sparse matrix files */
 {
-  FILE *fp;
-  int fl, nor, noc;
-  fp = FfReadHeader(name, &fl, &nor, &noc);
-  if (!fp)
+  long nor;
+  mappedFile_t *mf = mapfileplus(name);
+  if (!mf)
   {
     MTX_ERROR2("opening file %s: %E", name, MTX_ERR_FILEFMT);
     return -1;
   }
-  fclose(fp);
+  nor = mf->nor;
+  unmapfileplus(mf);
   return nor;
 }
+
+/**
+ * NULL on error
+ ****/
+Matrix_t *mappedMatLoad(char *name)
+/* Like MatLoad, but reads the rows from a mapped view of the file.
+ * Also reads the files written by sparseMatSave and compressedMatSave.
+ * Sets FfOrder, FfNoc to required values. */
+{
+  Matrix_t *mat;
+  register long i, k;
+  register const char *src;
+  mappedFile_t *mf = mapfileplus(name);
+  if (!mf) return NULL;
+  if (mf->fl < 2 || mf->nor < 0 || mf->noc < 0)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+    return NULL;
+  }
+  FfSetField(mf->fl);
+  FfSetNoc(mf->noc);
+  mat = MatAlloc(mf->fl, mf->nor, mf->noc);
+  if (!mat)
+  {
+    unmapfileplus(mf);
+    return NULL;
+  }
+  if (mf->offset)
+  {
+    if (mappedReadRows(mf, 0, mf->nor, mat->Data))
+    {
+      MatFree(mat);
+      mat = NULL;
+    }
+    unmapfileplus(mf);
+    return mat;
+  }
+  if (mf->length < (size_t) (mf->rows - (const char *) mf->base) +
+      mf->nnz * FfCurrentRowSizeIo)
+  {
+    MatFree(mat);
+    unmapfileplus(mf);
+    MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+    return NULL;
+  }
+  for (k = 0, src = mf->rows; k < mf->nnz; k++, src += FfCurrentRowSizeIo)
+  {
+    i = mf->index ? headerEntry((const unsigned char *) mf->index + 4 * k) : k;
+    if (i < 0 || i >= mf->nor)
+    {
+      MatFree(mat);
+      unmapfileplus(mf);
+      MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+      return NULL;
+    }
+    memcpy(FfGetPtr(mat->Data, i), src, FfCurrentRowSizeIo);
+  }
+  unmapfileplus(mf);
+  return mat;
+}
+
+/**
+ * 1 on error
+ ****/
+int sparseMatSave(Matrix_t *mat, char *name)
+/* Like MatSave, but only the nonzero rows are written, together with
+ * their indices. Only mappedMatLoad reads the result, so this must not be
+ * used for files that are read by MatLoad, see SPARSE_MATRIX_MAGIC. */
+{
+  FILE *fp;
+  long header[5];
+  long *index;
+  long i, nnz;
+  FEL f;
+  PTR row;
+  FfSetField(mat->Field);
+  FfSetNoc(mat->Noc);
+  index = (long *) malloc((mat->Nor + 1) * sizeof(long));
+  if (!index)
+  {
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  for (i = 0, nnz = 0, row = mat->Data; i < mat->Nor; i++, FfStepPtr(&row))
+    if (FfFindPivot(row, &f) >= 0) index[nnz++] = i;
+  header[0] = SPARSE_MATRIX_MAGIC;
+  header[1] = mat->Nor;
+  header[2] = mat->Noc;
+  header[3] = mat->Field;
+  header[4] = nnz;
+  fp = os_fopenplus(name, FM_CREATE);
+  if (!fp)
+  {
+    free(index);
+    return 1;
+  }
+  if (SysWriteLong(fp, header, 5) != 5 || SysWriteLong(fp, index, nnz) != nnz)
+  {
+    free(index);
+    fclose(fp);
+    MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  for (i = 0; i < nnz; i++)
+    if (FfWriteRows(fp, FfGetPtr(mat->Data, index[i]), 1) != 1)
+    {
+      free(index);
+      fclose(fp);
+      MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+      return 1;
+    }
+  free(index);
+  fclose(fp);
+  return 0;
+}
+
+/**
+ * 1 on error
+ ****/
+int sparsifyMatrixFile(char *name)
+/* Rewrites a dense matrix file in the format of sparseMatSave */
+{
+  int r;
+  Matrix_t *mat = mappedMatLoad(name);
+  if (!mat) return 1;
+  r = sparseMatSave(mat, name);
+  MatFree(mat);
+  return r;
+}
+
+/**
+ * 1 on error
+ ****/
+static int decompressBlock(mappedFile_t *mf, long b)
+/* Decompresses block b of a compressed file into mf->buffer */
+{
+  long rows = (b == mf->nblocks - 1) ? mf->nor - b * mf->blockRows : mf->blockRows;
+  uLongf len = (uLongf) (rows * FfCurrentRowSizeIo);
+  if (!mf->buffer)
+  {
+    mf->buffer = (char *) malloc(mf->blockRows * FfCurrentRowSizeIo);
+    if (!mf->buffer)
+    {
+      MTX_ERROR1("%E", MTX_ERR_NOMEM);
+      return 1;
+    }
+  }
+  mf->bufferedBlock = -1;
+  if (uncompress((Bytef *) mf->buffer, &len, (const Bytef *) mf->base + mf->offset[b],
+                 (uLong) (mf->offset[b+1] - mf->offset[b])) != Z_OK ||
+      len != (uLongf) (rows * FfCurrentRowSizeIo))
+  {
+    MTX_ERROR1("corrupted block: %E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  mf->bufferedBlock = b;
+  return 0;
+}
+
+/**
+ * 1 on error
+ ****/
+int mappedReadRows(mappedFile_t *mf, long first, long count, PTR dest)
+/* Copies the rows first,..., first+count-1 of a dense or compressed file
+ * to dest. FfNoc must be equal to mf->noc. Only the blocks of a compressed
+ * file containing these rows are decompressed, and the last of them is
+ * kept for the next call. */
+{
+  long i, k, b, rows;
+  const char *src;
+  if (first < 0 || count < 0 || first + count > mf->nor || mf->index)
+  {
+    MTX_ERROR1("%E", MTX_ERR_BADARG);
+    return 1;
+  }
+  if (!mf->offset)
+  {
+    if (mf->length < (size_t) (mf->rows - (const char *) mf->base) +
+        (first + count) * FfCurrentRowSizeIo)
+    {
+      MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+      return 1;
+    }
+    for (i = 0, src = mf->rows + first * FfCurrentRowSizeIo; i < count;
+         i++, src += FfCurrentRowSizeIo)
+      memcpy(FfGetPtr(dest, i), src, FfCurrentRowSizeIo);
+    return 0;
+  }
+  i = 0;
+  while (i < count)
+  {
+    b = (first + i) / mf->blockRows;
+    if (b != mf->bufferedBlock && decompressBlock(mf, b)) return 1;
+    rows = (b == mf->nblocks - 1) ? mf->nor - b * mf->blockRows : mf->blockRows;
+    k = first + i - b * mf->blockRows;
+    for (src = mf->buffer + k * FfCurrentRowSizeIo; i < count && k < rows;
+         i++, k++, src += FfCurrentRowSizeIo)
+      memcpy(FfGetPtr(dest, i), src, FfCurrentRowSizeIo);
+  }
+  return 0;
+}
+
+/**
+ * 1 on error
+ ****/
+static int compressedSave(char *name, long fl, long nor, long noc, long blockRows,
+                          const char *packed, Matrix_t *mat)
+/* Writes the rows, which are either given in MeatAxe file format by
+ * packed or else by mat, in the format of compressedMatSave */
+{
+  FILE *fp;
+  long header[6];
+  long *size;
+  long i, b, rows, nblocks;
+  size_t rowsize = FfCurrentRowSizeIo;
+  uLongf len;
+  char *in;
+  const char *src;
+  Bytef *out;
+  if (blockRows <= 0) blockRows = COMPRESSED_BLOCK_ROWS;
+  nblocks = (nor + blockRows - 1) / blockRows;
+  size = (long *) calloc(nblocks + 1, sizeof(long));
+  in = (packed) ? NULL : (char *) malloc(blockRows * rowsize + 1);
+  out = (Bytef *) malloc(compressBound((uLong) (blockRows * rowsize)));
+  if (!size || (!packed && !in) || !out)
+  {
+    if (size) free(size);
+    if (in) free(in);
+    if (out) free(out);
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  header[0] = COMPRESSED_MATRIX_MAGIC;
+  header[1] = nor;
+  header[2] = noc;
+  header[3] = fl;
+  header[4] = blockRows;
+  header[5] = nblocks;
+  fp = os_fopenplus(name, FM_CREATE);
+  /* The sizes of the blocks are written once they are known */
+  if (!fp || SysWriteLong(fp, header, 6) != 6 || SysWriteLong(fp, size, nblocks) != nblocks)
+  {
+    free(size); if (in) free(in); free(out);
+    if (fp) fclose(fp);
+    MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  for (b = 0; b < nblocks; b++)
+  {
+    rows = (b == nblocks - 1) ? nor - b * blockRows : blockRows;
+    if (packed)
+      src = packed + b * blockRows * rowsize;
+    else
+    {
+      for (i = 0; i < rows; i++)
+        memcpy(in + i * rowsize, FfGetPtr(mat->Data, b * blockRows + i), rowsize);
+      src = in;
+    }
+    len = compressBound((uLong) (blockRows * rowsize));
+    if (compress2(out, &len, (const Bytef *) src, (uLong) (rows * rowsize),
+                  Z_DEFAULT_COMPRESSION) != Z_OK ||
+        fwrite(out, 1, len, fp) != len)
+    {
+      free(size); if (in) free(in); free(out);
+      fclose(fp);
+      MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+      return 1;
+    }
+    size[b] = (long) len;
+  }
+  if (in) free(in);
+  free(out);
+  if (SysFseek(fp, (long) 24) || SysWriteLong(fp, size, nblocks) != nblocks)
+  {
+    free(size);
+    fclose(fp);
+    MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  free(size);
+  fclose(fp);
+  return 0;
+}
+
+/**
+ * 1 on error
+ ****/
+int compressedMatSave(Matrix_t *mat, char *name, long blockRows)
+/* Like MatSave, but the rows are compressed in blocks of blockRows rows
+ * (COMPRESSED_BLOCK_ROWS if blockRows <= 0), so that mappedReadRows only
+ * needs to decompress the blocks it reads. mappedMatLoad reads the result. */
+{
+  FfSetField(mat->Field);
+  FfSetNoc(mat->Noc);
+  return compressedSave(name, mat->Field, mat->Nor, mat->Noc, blockRows, NULL, mat);
+}
+
+/**
+ * 1 on error
+ ****/
+int compressMatrixFile(char *name, long blockRows)
+/* Rewrites a matrix file in the format of compressedMatSave.
+ * A dense file is compressed block by block, without loading it. */
+{
+  int r;
+  char tmpname[MAXLINE+4];
+  Matrix_t *mat;
+  mappedFile_t *mf = mapfileplus(name);
+  if (!mf) return 1;
+  if (mf->offset)
+  { /* already compressed */
+    unmapfileplus(mf);
+    return 0;
+  }
+  if (mf->index)
+  {
+    unmapfileplus(mf);
+    mat = mappedMatLoad(name);
+    if (!mat) return 1;
+    r = compressedMatSave(mat, name, blockRows);
+    MatFree(mat);
+    return r;
+  }
+  FfSetField(mf->fl);
+  FfSetNoc(mf->noc);
+  if (mf->nor < 0 || mf->length < 12 + mf->nor * FfCurrentRowSizeIo)
+  {
+    unmapfileplus(mf);
+    MTX_ERROR2("%s: %E", name, MTX_ERR_FILEFMT);
+    return 1;
+  }
+  /* The file is mapped, so the compressed data go to a new file */
+  sprintf(tmpname, "%s.tmp", name);
+  r = compressedSave(tmpname, mf->fl, mf->nor, mf->noc, blockRows, mf->rows, NULL);
+  unmapfileplus(mf);
+  if (!r && rename(tmpname, name))
+  {
+    MTX_ERROR1("Cannot rename %s", tmpname);
+    r = 1;
+  }
+  if (r) remove(tmpname);
+  return r;
+}
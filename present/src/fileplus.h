@@ -30,5 +30,35 @@
 #include "pcommon.h"
 #include "meataxe.h"
 
+/* Header entry marking a sparse matrix file. Its header is
+ * SPARSE_MATRIX_MAGIC, nor, noc, fl, nnz, followed by the indices of the
+ * nnz nonzero rows and then by these rows, everything as in MeatAxe files.
+ * The MeatAxe can not read such files. They are only written for the
+ * differentials and Urbild Groebner bases of a resolution, which are only
+ * read by mappedMatLoad. The matrices are dense in memory. */
+#define SPARSE_MATRIX_MAGIC (-21328)
+
+/* Header entry marking a compressed matrix file. Its header is
+ * COMPRESSED_MATRIX_MAGIC, nor, noc, fl, blockRows, nblocks, followed by
+ * the sizes of the nblocks compressed blocks and then by these blocks.
+ * Block i is the zlib compressed MeatAxe data of the rows
+ * i*blockRows,..., (i+1)*blockRows-1 */
+#define COMPRESSED_MATRIX_MAGIC (-21330)
+
+/* A read-only memory mapped MeatAxe file */
+typedef struct
+{
+  void *base;
+  size_t length;
+  long fl, nor, noc; /* the header */
+  long nnz; /* number of rows stored */
+  const char *index; /* row indices of a sparse file, NULL if dense */
+  const char *rows; /* rows of FfCurrentRowSizeIo bytes each, NULL if compressed */
+  long blockRows, nblocks; /* row blocks of a compressed file */
+  size_t *offset; /* nblocks+1 offsets of the compressed blocks, NULL if not compressed */
+  char *buffer; /* the decompressed block bufferedBlock */
+  long bufferedBlock;
+} mappedFile_t;
+
 #endif
 
@@ -34,5 +34,13 @@ FILE *readhdrplus(char *name, long *fl, long *nor, long *noc);
 /* Assigns to fl, nor, noc, unless NULL */
 void PrintMatrixFile(char *matname);
 long numberOfRowsStored(char *name);
+mappedFile_t *mapfileplus(char *name);
+void unmapfileplus(mappedFile_t *mf);
+Matrix_t *mappedMatLoad(char *name);
+int sparseMatSave(Matrix_t *mat, char *name);
+int sparsifyMatrixFile(char *name);
+int mappedReadRows(mappedFile_t *mf, long first, long count, PTR dest);
+int compressedMatSave(Matrix_t *mat, char *name, long blockRows);
+int compressMatrixFile(char *name, long blockRows);
 
 #endif
@@ -96,12 +96,18 @@ int main(int argc, const char *argv[])
 {
   if (Init(argc, argv))
   { MTX_ERROR("Error parsing command line. Try --help"); exit(1); }
-  if (loadNonTips(G)) exit(1);
-  if (buildPathTree(G)) exit(1);
-  if (loadActionMatrices(G)) exit(1);
+  if (loadGroupSnapshot(G))
+  {
+    if (loadNonTips(G)) exit(1);
+    if (buildPathTree(G)) exit(1);
+    if (loadActionMatrices(G)) exit(1);
+  }
   if (loadBasisChangeMatrices(G)) exit(1);
-  if (loadNonTips(H)) exit(1);
-  if (buildPathTree(H)) exit(1);
+  if (loadGroupSnapshot(H))
+  {
+    if (loadNonTips(H)) exit(1);
+    if (buildPathTree(H)) exit(1);
+  }
   if (makeInclusionMatrix(inclus)) exit(1);
   if (saveInclusionMatrix(inclus)) exit(1);
   Cleanup();
@@ -58,6 +58,13 @@ char *urbildGBFile(resol_t *resol, long n);
 nRgs_t *nRgsStandardSetup(resol_t *resol, long n, PTR mat);
 /* mat should be a block of length rankProj(resol, n-1) x rankProj(resol, n) */
 
+char *checkpointFile(resol_t *resol, long n);
+/* String returned must be used at once, never reused, never freed. */
+/* Represents an unfinished computation of d_n : P_n -> P_{n-1} */
+
+nRgs_t *nRgsCheckpointSetup(resol_t *resol, long n, char *file);
+/* As nRgsStandardSetup, restoring the vectors from a checkpoint */
+
 resol_t *newResolWithGroupLoaded (char *RStem, char *GStem, long N);
 void freeResolutionRecord(resol_t *resol);
 
@@ -65,7 +65,11 @@ static inline void updateCommonBuchStatus(ngs_t *ngs, group_t *group)
     ngs->prev_pnon = ngs->pnontips;
     ngs->unfruitful = 0;
   }
-  else ngs->unfruitful++;
+  else
+  {
+    ngs->unfruitful++;
+    ngs->stats.unfruitful++;
+  }
   return;
 }
 
@@ -78,22 +82,27 @@ static int nFgsExpandThisLevel(nFgs_t *nFgs, group_t *group)
   register long nor = ngs->r + ngs->s;
   register long pat, blo, a;
   register long dim = ngs->expDim;
+  long arrows = group->arrows;
   modW_t *node;
-  path_t *ext;
+  wordState_t *ws;
+  register const int32_t *ext, *kids;
   register PTR w;
   register rV_t *rv;
   register gV_t *gv;
+  double t0 = STATS_CLOCK(ngs);
   for (blo = 0; blo < ngs->r; blo++)
   {
+    ws = ngs->wstate + blo * group->nontips;
     for (pat = group->dS[dim]; pat < group->dS[dim+1]; pat++)
     {
+      if (ws[pat].status == NO_DIVISOR) continue;
       node = ngs->proot[blo] + pat;
-      if (node->status == NO_DIVISOR) continue;
       if (node->divisor->expDim > dim) continue; /* has already been expanded */
-      ext = group->root + node->qi;
-      for (a = 0; a < group->arrows; a++)
+      ext = group->pathChild + ws[pat].qi * arrows;
+      kids = group->pathChild + pat * arrows;
+      for (a = 0; a < arrows; a++)
       {
-        if (!ext->child[a] || node->child[a]) continue;
+        if (ext[a] < 0 || kids[a] >= 0) continue;
         w = nodeVector(ngs, group, node);
         if (!w) return 1;
         gv = popGeneralVector(ngs);
@@ -112,6 +121,8 @@ static int nFgsExpandThisLevel(nFgs_t *nFgs, group_t *group)
   for (rv = ngs->firstReduced; rv; rv = rv->next)
     if (rv->expDim == dim) rv->expDim++;
   ngs->expDim++;
+  ngs->stats.expansions++;
+  STATS_ADD_TIME(ngs, expandTime, t0);
   return 0;
 }
 
@@ -126,22 +137,27 @@ static int nRgsExpandThisLevel(nRgs_t *nRgs, group_t *group)
   long blo;
   register long a;
   long dim = ngs->expDim;
+  long arrows = group->arrows;
   modW_t *node;
-  path_t *ext;
+  wordState_t *ws;
+  register const int32_t *ext, *kids;
   register PTR w;
   register gV_t *gv;
   register rV_t *rv;
+  double t0 = STATS_CLOCK(ngs);
   for (blo = 0; blo < ngs->r; blo++)
   {
+    ws = ngs->wstate + blo * group->nontips;
     for (pat = group->dS[dim]; pat < group->dS[dim+1]; pat++)
     {
+      if (ws[pat].status == NO_DIVISOR) continue;
       node = ngs->proot[blo] + pat;
-      if (node->status == NO_DIVISOR) continue;
       if (node->divisor->expDim > dim) continue; /* has already been expanded */
-      ext = group->root + node->qi;
-      for (a = 0; a < group->arrows; a++)
+      ext = group->pathChild + ws[pat].qi * arrows;
+      kids = group->pathChild + pat * arrows;
+      for (a = 0; a < arrows; a++)
       {
-        if (!ext->child[a] || node->child[a]) continue;
+        if (ext[a] < 0 || kids[a] >= 0) continue;
         w = nodeVector(ngs, group, node);
         if (!w) return 1;
         gv = popGeneralVector(ngs);
@@ -168,6 +184,8 @@ static int nRgsExpandThisLevel(nRgs_t *nRgs, group_t *group)
   for (rv = ngs->firstReduced; rv; rv = rv->next)
     if (rv->expDim == dim) rv->expDim++;
   ngs->expDim++;
+  ngs->stats.expansions++;
+  STATS_ADD_TIME(ngs, expandTime, t0);
   return 0;
 }
 
@@ -245,6 +263,14 @@ static int checkRanksCorrect(nRgs_t *nRgs)
   return 1;
 }
 
+/******************************************************************************/
+static inline boolean checkpointDue(nRgs_t *nRgs)
+{
+  if (nRgs->checkpointInterval <= 0) return false;
+  return (statisticsClock() - nRgs->lastCheckpoint >= nRgs->checkpointInterval) ?
+    true : false;
+}
+
 /******************************************************************************/
 static void assertMinimalGeneratorsFound(nFgs_t *nFgs)
 {
@@ -269,6 +295,7 @@ static inline boolean shouldFetchMoreGenerators(nFgs_t *nFgs, group_t *group)
 int nFgsBuchberger(nFgs_t *nFgs, group_t *group)
 {
   register ngs_t *ngs = nFgs->ngs;
+  activateFieldContext(&ngs->fc);
   if (nFgsAufnahme (nFgs, group)) return 1;
   initializeCommonBuchStatus(ngs);
   int allExpDone;
@@ -309,9 +336,19 @@ int nRgsBuchberger(nRgs_t *nRgs, group_t *group)
 {
   register ngs_t *ngs = nRgs->ngs;
   register nFgs_t *ker = nRgs->ker;
-  ker->nRgsUnfinished = true;
-  if (nRgsAufnahme (nRgs, group)) return 1;
-  initializeCommonBuchStatus(ngs);
+  activateFieldContext(&ngs->fc);
+  if (nRgs->resumed) /* status data are taken from the checkpoint */
+  {
+    if (rebuildExpansionSlice(ngs, group)) return 1;
+    if (rebuildExpansionSlice(ker->ngs, group)) return 1;
+    nRgs->resumed = false;
+  }
+  else
+  {
+    ker->nRgsUnfinished = true;
+    if (nRgsAufnahme (nRgs, group)) return 1;
+    initializeCommonBuchStatus(ngs);
+  }
   int allExpDone, allExpDone2;
   while (allExpDone = allExpansionsDone(ngs, group) == 0)
   {
@@ -325,12 +362,18 @@ int nRgsBuchberger(nRgs_t *nRgs, group_t *group)
     if (allExpDone2==1) ker->nRgsUnfinished = false;
     if (allExpDone2==-1) return 1;
     updateCommonBuchStatus(ngs, group);
+    if (ngs->unfruitful == nRgs->overshoot) ngs->stats.overshoot++;
     if (nFgsAufnahme (ker, group)) return 1;
     if (appropriateToPerformHeadyBuchberger(nRgs, group))
     {
       if (nFgsBuchberger(ker, group)) return 1;
       if (ker->finished) break;
     }
+    if (checkpointDue(nRgs))
+    {
+      if (saveNRgsCheckpoint(nRgs, group, nRgs->checkpoint)) return 1;
+      nRgs->lastCheckpoint = statisticsClock();
+    }
   }
   if (allExpDone==-1) return 1;
   /* If targetRank known, then nFgsBuchberger guaranteed already finished. */
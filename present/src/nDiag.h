@@ -28,8 +28,10 @@
 
 #include "pcommon.h"
 #include "meataxe.h"
+#include "fileplus.h"
 #include "pgroup.h"
 #include "pgroup_decls.h"
+#include <time.h>
 
 #define RANK_UNKNOWN -1
 #define ZERO_BLOCK -1
@@ -39,6 +41,9 @@
 #define NOTHING_TO_EXPAND -1
 #define NO_BUCHBERGER_REQUIRED -2
 
+/* First entry of a checkpoint file of a nRgs_t */
+#define CHECKPOINT_MAGIC -21329
+
 /* Status of modW_t's */
 #define NO_DIVISOR -1
 #define SCALAR_MULTIPLE -2
@@ -50,6 +55,11 @@ static const boolean true = 1;
 static const boolean false = 0;
 #endif
 
+/* Levels of the skip lists indexing the reduced and unreduced vectors;
+ * level 0 is the doubly linked list prev/next, so entry 0 of the arrays
+ * skipNext, skipPrev is unused */
+#define SKIP_LEVELS 12
+
 struct generalVector;
 typedef struct generalVector gV_t;
 
@@ -62,6 +72,7 @@ struct generalVector
   long block;
   int col;
   boolean radical;
+  gV_t *nextFree; /* free list of the vector pool */
 };
 
 struct unreducedVector;
@@ -72,6 +83,8 @@ struct unreducedVector
   gV_t *gv;
   long index;
   uV_t *prev, *next;
+  int level;
+  uV_t *skipNext[SKIP_LEVELS], *skipPrev[SKIP_LEVELS];
 };
 
 struct moduleWord;
@@ -86,27 +99,112 @@ struct reducedVector
   modW_t *node;
   rV_t *next, *prev;
   long expDim;
+  int level;
+  rV_t *skipNext[SKIP_LEVELS], *skipPrev[SKIP_LEVELS];
 };
 
+/* The trees of the word forest have the shape of group->root, so the
+ * children of a word are found by group->pathChild */
 struct moduleWord
 {
-  modW_t *parent, **child;
+  modW_t *parent;
   rV_t *divisor;
-  long qi;     /* index of quotient path */
-  long status;
 };
 
+/* Status and quotient path of the words of the forest. They are kept in
+ * one array apart from the modW_t, so that a scan over the words of a
+ * dimension reads contiguous memory */
+typedef struct
+{
+  int32_t status;
+  int32_t qi;     /* index of quotient path */
+} wordState_t;
+
+struct storedSlice;
+typedef struct storedSlice sS_t;
+
+struct storedSlice /* products of one dimension, kept in memory */
+{
+  long dim;
+  long rows;
+  PTR data;
+  sS_t *next;
+};
+
+struct vectorSlab;
+typedef struct vectorSlab vS_t;
+
+struct vectorSlab /* VECTOR_SLAB vectors of r+s rows, allocated at once */
+{
+  gV_t *gv;
+  uV_t *uv;
+  rV_t *rv;
+  PTR rows;
+  vS_t *next;
+};
+
+struct buchbergerStatistics;
+typedef struct buchbergerStatistics bStat_t;
+
+struct buchbergerStatistics /* counters and timings (in seconds) of one ngs */
+/* The time for block reads is also contained in expandTime and reduceTime.
+ * The timings are only taken if ngs->timing is set, see STATS_CLOCK */
+{
+  long expansions;  /* calls of n?gsExpandThisLevel */
+  double expandTime;
+  long products;    /* rows computed by calculateNextProducts */
+  double productTime;
+  long blockReads;  /* blocks read from .stp files by loadBlock */
+  long blockBytes;
+  double readTime;
+  long reductions;  /* calls of reduceTipOnce and reduceMonicTipOnce */
+  double reduceTime;
+  long promotions, demotions;
+  long unfruitful;  /* expansions that did not decrease pnontips */
+  long overshoot;   /* times that unfruitful reached nRgs->overshoot */
+};
+
+static inline double statisticsClock(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/* Start resp. stop the clock for a timing in ngs->stats. The counters are
+ * always updated, but clock_gettime is only called if ngs->timing is set */
+#define STATS_CLOCK(ngs) ((ngs)->timing ? statisticsClock() : 0.0)
+#define STATS_ADD_TIME(ngs, field, t0) \
+  do { if ((ngs)->timing) (ngs)->stats.field += statisticsClock() - (t0); } while (0)
+
 struct newCommonGeneratingSet;
 typedef struct newCommonGeneratingSet ngs_t;
 
+/* Kernels acting on a whole block of rows of the given number of bytes,
+ * chosen for the field by selectBlockKernels */
+typedef void (*blockSub_t)(PTR dest, PTR src, size_t bytes);
+typedef void (*blockAddMul_t)(PTR dest, PTR src, FEL f, size_t bytes);
+typedef void (*blockMul_t)(PTR dest, FEL f, size_t bytes);
+
 struct newCommonGeneratingSet
 {
   long r, s; /* r is rank of ambient free, s rank of preimage (0 for fgs) */
+  fieldContext_t fc; /* row geometry of the vectors, copied from the group */
+  blockSub_t subBlock; /* dest -= src */
+  blockAddMul_t addMulBlock; /* dest += f*src */
+  blockMul_t mulBlock; /* dest *= f */
   rV_t *firstReduced;
   rV_t *lastReduced;
   uV_t *unreducedHeap;
+  rV_t *reducedSkip[SKIP_LEVELS]; /* heads of the skip lists */
+  uV_t *unreducedSkip[SKIP_LEVELS];
+  unsigned long skipSeed;
   modW_t **proot;
-  gV_t *gVwaiting;
+  wordState_t *wstate; /* wstate[blo*nontips+pat] belongs to proot[blo]+pat */
+  vS_t *slabs; /* vector pool, released by freeNgs */
+  gV_t *freeGV;
+  uV_t *freeUV;
+  rV_t *freeRV;
   long pnontips; /* present guess at the number of nontips */
   long expDim;
   long targetRank;
@@ -119,6 +217,19 @@ struct newCommonGeneratingSet
   long blockSize;
   char stem[MAXLINE];
   long prev_pnon, unfruitful;
+  long threads; /* number of threads used in calculateNextProducts */
+  sS_t *slices; /* slices kept in memory */
+  sS_t *sliceLoaded; /* NULL if dimLoaded is stored on disk */
+  mappedFile_t *sliceMap; /* mapped .stp file of dimLoaded, if on disk */
+  long cacheSize; /* number of blocks of dimLoaded kept in memory */
+  PTR *cachedBlock; /* cachedBlock[0] is thisBlock */
+  long *cachedIndex, *cachedUse; /* block held by a slot, time of last use */
+  long cacheClock, cacheHits, cacheMisses;
+  PTR blockData; /* data of blockLoaded */
+  size_t sliceMemory, sliceBytes; /* memory budget and memory used by slices */
+  boolean compressSlices; /* whether .stp files are compressed */
+  boolean timing; /* whether stats contains timings */
+  bStat_t stats;
 };
 
 struct newFlaggedGeneratingSet
@@ -131,11 +242,19 @@ struct newFlaggedGeneratingSet
 
 typedef struct newFlaggedGeneratingSet nFgs_t;
 
+static inline wordState_t *wordState(ngs_t *ngs, modW_t *node)
+{
+  return ngs->wstate + (node - ngs->proot[0]);
+}
+
 struct newResentfulGeneratingSet
 {
   nFgs_t *ker; /* ker is the hgs for the known part of kernel */
   ngs_t *ngs;
   long prev_ker_pnon, overshoot;
+  boolean resumed; /* restored from a checkpoint, slices not yet rebuilt */
+  double checkpointInterval, lastCheckpoint; /* seconds; 0 means never */
+  char checkpoint[MAXLINE]; /* name of the checkpoint file */
 };
 
 typedef struct newResentfulGeneratingSet nRgs_t;
@@ -144,10 +263,10 @@ typedef struct newResentfulGeneratingSet nRgs_t;
 #if !defined(NULL)
 #define NULL NULL
 #endif
-extern gV_t *generalVectorTemplate(long nor);
+extern gV_t *pooledGeneralVector(ngs_t *ngs);
 
 #if !defined(popGeneralVector)
-#define popGeneralVector(ngs) ({gV_t *GV_; ((ngs)->gVwaiting) ? ({ GV_ = (ngs)->gVwaiting; (ngs)->gVwaiting = NULL; GV_;}) : ({ GV_ = generalVectorTemplate((ngs)->r + (ngs)->s); GV_;});})
+#define popGeneralVector(ngs) pooledGeneralVector(ngs)
 #endif
 
 
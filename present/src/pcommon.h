@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #define DJG_DEBUG
 
@@ -58,4 +59,23 @@
   #define MAX_OVERSHOOT 1
 #endif
 
+/* Number of blocks of stored products kept in memory, see nodeVector */
+#define BLOCK_CACHE 4
+
+/* Number of vectors allocated at once by the vector pool of an ngs_t */
+#define VECTOR_SLAB 32
+
+/* Number of pivots found before the other rows are cleared in autoliftPreimages */
+#define AUTOLIFT_PANEL 64
+
+/* Default number of rows per block of a compressed matrix file */
+#define COMPRESSED_BLOCK_ROWS 256
+
+/* Number of threads computing the products of one slice */
+#define WORKER_THREADS 1
+#define MAX_WORKER_THREADS 256
+
+/* Bytes of products per ngs_t kept in memory instead of .stp files */
+#define SLICE_MEMORY (128L << 20)
+
 #endif
@@ -23,6 +23,10 @@
 #include "pgroup.h"
 #include "pgroup_decls.h"
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
 
 MTX_DEFINE_FILE_INFO
 
@@ -106,9 +110,31 @@ group_t *newGroupRecord (void)
   group->bch = NULL;
   group->dim = NULL;
   group->dS = NULL;
+  group->pathDepth = NULL;
+  group->pathChild = NULL;
+  group->rcache = NULL;
+  group->lcache = NULL;
+  group->cacheLimit = 0;
+  group->cacheBytes = 0;
+  group->cacheHits = 0;
+  group->cacheMisses = 0;
+  memset(&group->fc, 0, sizeof(fieldContext_t));
   return group;
 }
 
+/******************************************************************************/
+void setFieldContext(fieldContext_t *fc, long fl, long noc)
+/* Also makes fc the current field of the MeatAxe */
+{
+  FfSetField(fl);
+  FfSetNoc(noc);
+  fc->fl = fl;
+  fc->noc = noc;
+  fc->rowSize = FfCurrentRowSize;
+  fc->rowSizeIo = FfCurrentRowSizeIo;
+  return;
+}
+
 /****
  * NULL on error
  ***************************************************************************/
@@ -443,8 +469,7 @@ int loadNonTips(group_t *group)
       free(buffer);
       return 1;
   }
-  FfSetField(group->p);
-  FfSetNoc(nontips);
+  setFieldContext(&group->fc, group->p, nontips);
   //  nontip = (char **) malloc(nontips * sizeof(char *));
   nontip = (char **) malloc(nontips * sizeof(void*));
   if (!nontip)
@@ -562,6 +587,40 @@ int buildPathTree(group_t *group)
     this->lastArrow = arrow - 'a';
   }
   group->root = root;
+  return flattenPathTree(group);
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int flattenPathTree(group_t *group)
+/* Index tables for group->root. They are used in the loops of the
+ * Buchberger algorithm instead of the pointers of the path_t */
+{
+  register long i, a;
+  long arrows = group->arrows;
+  long nontips = group->nontips;
+  path_t *root = group->root;
+  if (group->pathDepth) free(group->pathDepth);
+  if (group->pathChild) free(group->pathChild);
+  group->pathDepth = (int32_t *) malloc(nontips * sizeof(int32_t));
+  group->pathChild = (int32_t *) malloc(nontips * arrows * sizeof(int32_t));
+  if (!group->pathDepth || !group->pathChild)
+  {
+    if (group->pathDepth) free(group->pathDepth);
+    if (group->pathChild) free(group->pathChild);
+    group->pathDepth = NULL;
+    group->pathChild = NULL;
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  for (i = 0; i < nontips; i++)
+  {
+    group->pathDepth[i] = (int32_t) root[i].depth;
+    for (a = 0; a < arrows; a++)
+      group->pathChild[i * arrows + a] =
+        (root[i].child[a]) ? (int32_t) root[i].child[a]->index : -1;
+  }
   return 0;
 }
 
@@ -842,6 +901,29 @@ inline void freeActionMatrices(Matrix_t **mat)
   free(mat);
 }
 
+/******************************************************************************
+ * Wide XOR kernel, see WIDE_KERNEL in pgroup.h. Used by FfAddMapRow for
+ * rows of at least 4 longs (shorter rows are added inline, avoiding the
+ * indirect call of the dispatched kernel), and for the blocks of vectors
+ * in the Buchberger algorithm over GF(2).
+ */
+WIDE_KERNEL void xorLongs(long *dest, const long *src, long n)
+/* dest ^= src, n longs */
+{
+  register long k = 0;
+#if defined(__GNUC__)
+  for (; k + 4 <= n; k += 4)
+  {
+    wideLong_t x, y;
+    memcpy(&x, dest + k, sizeof(wideLong_t));
+    memcpy(&y, src + k, sizeof(wideLong_t));
+    x ^= y;
+    memcpy(dest + k, &x, sizeof(wideLong_t));
+  }
+#endif
+  for (; k < n; k++) dest[k] ^= src[k];
+}
+
 /******************************************************************************
  * The following is basically a copy of FfMapRow, deleting some assembly code.
  * Only difference: The @em result is not initialized to zero.
@@ -853,39 +935,55 @@ inline void freeActionMatrices(Matrix_t **mat)
  ** @param matrix A matrix (nor by nor).
  ** @param nor Number of rows in the matrix. It must coincide with FfCurrentRowSizeIo*MPB.
  ** @param[out] result The resulting vector (nor columns).
+ ** Over GF(2), 64 zero entries of @em row are skipped at once, and rows of
+ ** @em matrix are added by xorLongs if they have at least 4 longs, and
+ ** inline otherwise. Over other fields, zero bytes of
+ ** @em row are skipped at once.
 */
 void FfAddMapRow(PTR row, PTR matrix, int nor, PTR result)
 {
     register int i;
     register FEL f;
     BYTE *m = (BYTE *) matrix;
-    register long *l = (long *)result;
 
     if (FfOrder == 2)       /* GF(2) is a special case */
     {
         register long *x1 = (long *) matrix;
         register BYTE *r = (BYTE *) row;
+        register long lpr = LPR;
+        register long k;
+        const int wide = (lpr >= 4);
+        unsigned long chunk;
 
         for (i = nor; i > 0; ++r)
         {
             register BYTE mask;
+            if (i >= 8 * (int) sizeof(long))
+            {
+                memcpy(&chunk, r, sizeof(long));
+                if (chunk == 0)   /* Skip 8*sizeof(long) rows */
+                {
+                    i -= 8 * sizeof(long);
+                    x1 += 8 * sizeof(long) * lpr;
+                    r += sizeof(long) - 1;
+                    continue;
+                }
+            }
             if (*r == 0)   /* Skip eight rows */
             {
             i -= 8;
-            x1 += 8 * LPR;
+            x1 += 8 * lpr;
             continue;
             }
-            for (mask = 0x80; mask != 0 && i > 0; mask >>= 1, --i)
+            for (mask = 0x80; mask != 0 && i > 0; mask >>= 1, --i, x1 += lpr)
             {
-                if ((mask & *r) == 0)
+                if ((mask & *r) != 0)
                 {
-                    x1 += LPR;  /* Skip that row */
-                    continue;
+                    if (wide)
+                        xorLongs((long *) result, x1, lpr);
+                    else
+                        for (k = 0; k < lpr; k++) ((long *) result)[k] ^= x1[k];
                 }
-                register long *x2 = (long *)result;
-                register int k;
-                for (k = LPR; k; --k)
-                    *x2++ ^= *x1++;
             }
         }
     }
@@ -896,6 +994,13 @@ void FfAddMapRow(PTR row, PTR matrix, int nor, PTR result)
 
         for (i = nor; i > 0; --i)
         {
+            if (pos == 0 && *brow == 0 && i >= (int) MPB)
+            {   /* Skip MPB rows */
+                i -= MPB - 1;
+                ++brow;
+                m += MPB * FfCurrentRowSize;
+                continue;
+            }
             f = mtx_textract[pos][*brow];
             if (++pos == (int) MPB)
             {
@@ -969,6 +1074,9 @@ void freeGroupRecord (group_t *group)
   if (group->bch) freeActionMatrices (group->bch);
   if (group->dim) free(group->dim);
   if (group->dS) free(group->dS);
+  if (group->pathDepth) free(group->pathDepth);
+  if (group->pathChild) free(group->pathChild);
+  disableActionMatrixCache(group);
   free (group);
   return;
 }
@@ -1051,11 +1159,11 @@ boolean smallerJenningsWord(JenningsWord_t *w1, JenningsWord_t *w2)
 }
 
 /******************************************************************************/
-void innerRightActionMatrix(group_t *group, PTR vec, PTR dest)
+static void buildRightActionMatrix(group_t *group, PTR vec, PTR dest)
 {
   register int i;
   PTR this = dest+FfCurrentRowSize;
-  memcpy(dest, vec, FfCurrentRowSize);
+  if (dest != vec) memcpy(dest, vec, FfCurrentRowSize);
   for (i = 1; i < group->nontips; i++, this+=FfCurrentRowSize)
   {
     FfMapRow(FfGetPtr(dest, group->lroot[i].parent->index), group->laction[group->lroot[i].lastArrow]->Data, group->nontips, this);
@@ -1064,11 +1172,11 @@ void innerRightActionMatrix(group_t *group, PTR vec, PTR dest)
 }
 
 /******************************************************************************/
-void innerLeftActionMatrix(group_t *group, PTR vec, PTR dest)
+static void buildLeftActionMatrix(group_t *group, PTR vec, PTR dest)
 {
   register int i;
   PTR this = dest + FfCurrentRowSize;
-  memcpy(dest, vec, FfCurrentRowSize);
+  if (dest != vec) memcpy(dest, vec, FfCurrentRowSize);
   for (i = 1; i < group->nontips; i++, this+=FfCurrentRowSize)
   {
     FfMapRow(FfGetPtr(dest, group->root[i].parent->index), group->action[group->root[i].lastArrow]->Data, group->nontips, this);
@@ -1076,6 +1184,148 @@ void innerLeftActionMatrix(group_t *group, PTR vec, PTR dest)
   return;
 }
 
+/******************************************************************************
+ * Cache of the action matrices of the nontips.
+ * If enabled, the action matrix of a vector with few nonzero coefficients is
+ * assembled as a linear combination of the action matrices of the nontips,
+ * which are computed on first use and kept as long as the memory used by
+ * the cache does not exceed group->cacheLimit bytes.
+ */
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int enableActionMatrixCache(group_t *group, long bytes)
+{
+  register long i;
+  if (bytes <= 0)
+  {
+    disableActionMatrixCache(group);
+    return 0;
+  }
+  group->cacheLimit = bytes;
+  if (group->rcache) return 0;
+  group->rcache = (PTR *) malloc(group->nontips * sizeof(PTR));
+  group->lcache = (PTR *) malloc(group->nontips * sizeof(PTR));
+  if (!group->rcache || !group->lcache)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    disableActionMatrixCache(group);
+    return 1;
+  }
+  for (i = 0; i < group->nontips; i++)
+  {
+    group->rcache[i] = NULL;
+    group->lcache[i] = NULL;
+  }
+  group->cacheBytes = 0;
+  group->cacheHits = 0;
+  group->cacheMisses = 0;
+  return 0;
+}
+
+/******************************************************************************/
+void disableActionMatrixCache(group_t *group)
+{
+  register long i;
+  if (group->rcache)
+  {
+    for (i = 0; i < group->nontips; i++)
+      if (group->rcache[i]) free(group->rcache[i]);
+    free(group->rcache);
+  }
+  if (group->lcache)
+  {
+    for (i = 0; i < group->nontips; i++)
+      if (group->lcache[i]) free(group->lcache[i]);
+    free(group->lcache);
+  }
+  group->rcache = NULL;
+  group->lcache = NULL;
+  group->cacheLimit = 0;
+  group->cacheBytes = 0;
+  return;
+}
+
+/******************************************************************************/
+void actionMatrixCacheStatistics(group_t *group, long *bytes, long *hits,
+  long *misses)
+{
+  *bytes = group->cacheBytes;
+  *hits = group->cacheHits;
+  *misses = group->cacheMisses;
+  return;
+}
+
+/******************************************************************************/
+static PTR cachedActionMatrix(group_t *group, PTR *cache, long i, boolean right)
+/* Action matrix of the i-th nontip; NULL if it is not cached and there is
+ * no room (or no memory) for it */
+{
+  long size = group->nontips * FfCurrentRowSize;
+  PTR mat;
+  if (cache[i])
+  {
+    group->cacheHits++;
+    return cache[i];
+  }
+  group->cacheMisses++;
+  if (group->cacheBytes + size > group->cacheLimit) return NULL;
+  mat = FfAlloc(group->nontips);
+  if (!mat) return NULL;
+  FfInsert(mat, i, FF_ONE);
+  if (right) buildRightActionMatrix(group, mat, mat);
+  else buildLeftActionMatrix(group, mat, mat);
+  cache[i] = mat;
+  group->cacheBytes += size;
+  return mat;
+}
+
+/******************************************************************************/
+static boolean combineActionMatrices(group_t *group, PTR vec, PTR dest,
+  boolean right)
+/* false if the action matrix of vec should rather be built from scratch */
+{
+  PTR *cache = (right) ? group->rcache : group->lcache;
+  register long i, k, nnz = 0;
+  register PTR this, src;
+  FEL f;
+  PTR mat;
+  if (!cache) return false;
+  for (i = 0; i < group->nontips; i++)
+    if (FfExtract(vec, i) != FF_ZERO) nnz++;
+  if (4 * nnz > group->nontips) return false;
+  for (i = 0; i < group->nontips; i++)
+    if (FfExtract(vec, i) != FF_ZERO && !cachedActionMatrix(group, cache, i, right))
+      return false;
+  memset(dest, 0, group->nontips * FfCurrentRowSize);
+  for (i = 0; i < group->nontips; i++)
+  {
+    f = FfExtract(vec, i);
+    if (f == FF_ZERO) continue;
+    mat = cache[i];
+    for (k = 0, this = dest, src = mat; k < group->nontips;
+         k++, this+=FfCurrentRowSize, src+=FfCurrentRowSize)
+      FfAddMulRow(this, src, f);
+  }
+  return true;
+}
+
+/******************************************************************************/
+void innerRightActionMatrix(group_t *group, PTR vec, PTR dest)
+{
+  if (combineActionMatrices(group, vec, dest, true)) return;
+  buildRightActionMatrix(group, vec, dest);
+  return;
+}
+
+/******************************************************************************/
+void innerLeftActionMatrix(group_t *group, PTR vec, PTR dest)
+{
+  if (combineActionMatrices(group, vec, dest, false)) return;
+  buildLeftActionMatrix(group, vec, dest);
+  return;
+}
+
 /******************************************************************************/
 inline Matrix_t *rightActionMatrix(group_t *group, PTR vec)
 {
@@ -1092,9 +1342,97 @@ inline Matrix_t *leftActionMatrix(group_t *group, PTR vec)
   return mat;
 }
 
+/****
+ * 1 on error
+ ***************************************************************************/
+static int addProducts(PTR rows, long n, PTR mat, long nontips, PTR prod,
+  PTR dest, long stride)
+/* dest_k += rows_k * mat for k < n, using one Strassen multiplication.
+ * The n rows are consecutive, dest_k is row k*stride of dest.
+ * prod: scratch space, n rows */
+{
+  Matrix_t Rows, Mat;
+  register long k;
+  Rows.Magic = MAT_MAGIC;
+  Rows.Field = FfOrder;
+  Rows.Nor = n;
+  Rows.Noc = nontips;
+  Rows.PivotTable = NULL;
+  Rows.Data = rows;
+  Rows.RowSize = FfCurrentRowSize;
+  Mat.Magic = MAT_MAGIC;
+  Mat.Field = FfOrder;
+  Mat.Nor = nontips;
+  Mat.Noc = nontips;
+  Mat.PivotTable = NULL;
+  Mat.Data = mat;
+  Mat.RowSize = FfCurrentRowSize;
+  if (innerRightProduct(&Rows, &Mat, prod)) return 1;
+  for (k = 0; k < n; k++)
+    FfAddRow(FfGetPtr(dest, k * stride), FfGetPtr(prod, k));
+  return 0;
+}
+
 /******************************************************************************/
-void innerRightCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
-  long q, PTR scratch, PTR gamma)
+static inline boolean isZeroRow(PTR row)
+{
+  FEL f;
+  return (FfFindPivot(row, &f) == -1) ? true : false;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int innerRightComposeMany(group_t *group, PTR alpha, long s, long r, long n,
+  PTR *beta, long *q, PTR *gamma)
+/* alpha: matrix representing map from free rk s to free rk r
+   beta[m] : free rk r to free rk q[m], for m < n
+   Adds the composition of alpha and beta[m] to gamma[m] (s * q[m] rows).
+   The right action matrix of each nonzero alpha_ji is built only once,
+   and applied to the q[m] consecutive rows beta[m]_{.j} by one matrix
+   product per m.
+*/
+{
+  long nontips = group->nontips;
+  long i, j, m, qmax = 1;
+  PTR alpha_ji, mat, prod;
+  for (m = 0; m < n; m++)
+    if (q[m] > qmax) qmax = q[m];
+  FfSetNoc(nontips);
+  mat = FfAlloc(nontips);
+  prod = FfAlloc(qmax);
+  if (!mat || !prod)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    if (mat) free(mat);
+    return 1;
+  }
+  alpha_ji = alpha;
+  for (i = 0; i < s; i++)
+    for (j = 0; j < r; j++, alpha_ji+=FfCurrentRowSize)
+    {
+      if (isZeroRow(alpha_ji)) continue;
+      innerRightActionMatrix(group, alpha_ji, mat);
+      for (m = 0; m < n; m++)
+      {
+        if (!q[m]) continue;
+        if (addProducts(FfGetPtr(beta[m], j * q[m]), q[m], mat, nontips, prod,
+                        FfGetPtr(gamma[m], i * q[m]), 1))
+        { free(mat);
+          free(prod);
+          return 1;
+        }
+      }
+    }
+  free(mat);
+  free(prod);
+  return 0;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int innerRightCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
+  long q, PTR gamma)
 /* alpha: matrix representing map from free rk s to free rk r
    beta : free rk r to free rk q
    free = free RIGHT G-module
@@ -1102,32 +1440,62 @@ void innerRightCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
    Then gamma s * q rows
    gamma_{ki} = \sum_{j=1}^r beta_{kj} alpha_{ji}
    gamma must be initialised before calling innerCompose
-   scratch: scratch space, nontips+1 rows
    Right: use right action matrix of alpha_ji
 */
+{
+  return innerRightComposeMany(group, alpha, s, r, 1, &beta, &q, &gamma);
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int innerComposeChainMaps(group_t *group, PTR M1, PTR M2, long RK, long Rk,
+  long rk, PTR out)
+/* M1: map from free rk RK to free rk Rk, M2: free rk Rk to free rk rk
+   out (RK * rk rows) must be initialised; the composition is added to it:
+   out_{ki} = \sum_j M1_{kj} M2_{ji}
+   If RK <= rk, the right action matrices of the M1_{kj} are used,
+   otherwise the left action matrices of the M2_{ji}, such that the smaller
+   number of action matrices is built. In both cases, each action matrix is
+   applied to a block of rows by one matrix product.
+*/
 {
   long nontips = group->nontips;
-  long i,j,k;
-  PTR alpha_ji, beta_kj, gamma_ki;
-  PTR mat = scratch, tmp = FfGetPtr(scratch, nontips);
-  alpha_ji = alpha;
-  for (i = 0; i < s; i++)
+  long i, j, k;
+  PTR A, L, prod, M2_ji;
+  if (RK <= rk)
+    return innerRightComposeMany(group, M1, RK, Rk, 1, &M2, &rk, &out);
+  FfSetNoc(nontips);
+  A = FfAlloc(RK);
+  L = FfAlloc(nontips);
+  prod = FfAlloc(RK);
+  if (!A || !L || !prod)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    if (A) free(A);
+    if (L) free(L);
+    return 1;
+  }
+  M2_ji = M2;
+  for (j = 0; j < Rk; j++)
   {
-    beta_kj = beta;
-    for (j = 0; j < r; j++, alpha_ji+=FfCurrentRowSize)
+    for (k = 0; k < RK; k++)
+      memcpy(FfGetPtr(A, k), FfGetPtr(M1, k * Rk + j), FfCurrentRowSize);
+    for (i = 0; i < rk; i++, M2_ji+=FfCurrentRowSize)
     {
-      /*alpha_ji = FfGetPtr(alpha, j + i * r);*/
-      innerRightActionMatrix(group, alpha_ji, mat);
-      gamma_ki = FfGetPtr(gamma, i * q);
-      for (k = 0; k < q; k++, beta_kj+=FfCurrentRowSize, gamma_ki+=FfCurrentRowSize)
-      {
-        /*beta_kj = FfGetPtr(beta, k + j * q);
-        gamma_ki = FfGetPtr(gamma, k + i * q);*/
-        FfAddMapRow(beta_kj, mat, nontips, gamma_ki);
+      if (isZeroRow(M2_ji)) continue;
+      innerLeftActionMatrix(group, M2_ji, L);
+      if (addProducts(A, RK, L, nontips, prod, FfGetPtr(out, i), rk))
+      { free(A);
+        free(L);
+        free(prod);
+        return 1;
       }
     }
   }
-  return;
+  free(A);
+  free(L);
+  free(prod);
+  return 0;
 }
 
 /******************************************************************************/
@@ -1218,6 +1586,34 @@ int convertPermutationsToAsci(const char *infile, const char *outfile)
   return 0;
 }
 
+/******************************************************************************/
+void setRegularActionMatrices(group_t *group, Matrix_t **action,
+  const long *perm, long num)
+/* perm[i*nontips+j] is the image of j+1 under the i-th generator.
+ * action[i] becomes the action of the i-th generator minus one. */
+{
+  long nontips = group->nontips;
+  PTR ptr;
+  FEL F_MINUS = FfNeg(FF_ONE);
+  long i,j;
+  for (i = 0; i < num; i++)
+  {
+    ptr = action[i]->Data;
+    for (j = 0; j < nontips; j++, FfStepPtr(&ptr))
+      FfInsert(ptr, j, F_MINUS);
+  }
+  for (i = 0; i < num; i++, perm += nontips)
+  {
+    ptr = action[i]->Data;
+    for (j = 0; j < nontips; j++, FfStepPtr(&ptr))
+      /* For backwards compatibility, we have a shift by one when reading
+       * or saving the action matrices
+       */
+      FfInsert(ptr, perm[j]-1, (perm[j]-1 == j) ? FF_ZERO : FF_ONE);
+  }
+  return;
+}
+
 /****
  * 1 on error
  ***************************************************************************/
@@ -1225,9 +1621,7 @@ int loadGeneralRegularActionMatrices(group_t *group, Matrix_t **action,
   char *name, long num)
 {
   long buffer[3], nontips = group->nontips;
-  PTR ptr;
-  FEL F_MINUS = FfNeg(FF_ONE);
-  long i,j;
+  long *perm;
   FILE *fp;
   fp = SysFopen(name, FM_READ);
   if (!fp) return 1;
@@ -1242,29 +1636,21 @@ int loadGeneralRegularActionMatrices(group_t *group, Matrix_t **action,
     MTX_ERROR1("incompatible file header: %E", MTX_ERR_FILEFMT);
     return 1;
   }
-  for (i = 0; i < num; i++)
-  {
-    ptr = action[i]->Data;
-    for (j = 0; j < nontips; j++, FfStepPtr(&ptr))
-      FfInsert(ptr, j, F_MINUS);
+  perm = (long *) malloc(num * nontips * sizeof(long));
+  if (!perm)
+  { fclose(fp);
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
   }
-  for (i = 0; i < num; i++)
-  {
-    ptr = action[i]->Data;
-    for (j = 0; j < nontips; j++, FfStepPtr(&ptr))
-    {
-      if (SysReadLong(fp,buffer,1) != 1)
-      { fclose(fp);
-        MTX_ERROR1("reading body: %E", MTX_ERR_FILEFMT);
-        return 1;
-      }
-      /* For backwards compatibility, we have a shift by one when reading
-       * or saving the action matrices
-       */
-      FfInsert(ptr, buffer[0]-1, (buffer[0]-1 == j) ? FF_ZERO : FF_ONE);
-    }
+  if (SysReadLong(fp, perm, num * nontips) != num * nontips)
+  { free(perm);
+    fclose(fp);
+    MTX_ERROR1("reading body: %E", MTX_ERR_FILEFMT);
+    return 1;
   }
   fclose(fp);
+  setRegularActionMatrices(group, action, perm, num);
+  free(perm);
   return 0;
 }
 
@@ -1369,8 +1755,7 @@ int innerRightProduct(const Matrix_t *dest, const Matrix_t *src, PTR scratch)
  * which is not required to be empty. */
 {
   Matrix_t Res;
-  FfSetField(src->Field);
-  FfSetNoc(src->Noc);
+  selectField(src->Field, src->Noc);
   memset(scratch, 0, dest->Nor*FfCurrentRowSize);
   Res.Magic = dest->Magic;
   Res.Field = dest->Field;
@@ -1506,6 +1891,592 @@ int changeActionMatricesReg2Nontips(group_t *group)
   return r;
 }
 
+/******************************************************************************
+ * Construction of nontips, formerly part of makeNontips.
+ *
+ * constructNontips_LengthLex, constructNontips_ReverseLengthLex and
+ * constructNontips_Jennings set group->nontip, group->maxlength and
+ * group->mintips, as if they were read by loadNonTips. saveNonTips
+ * writes them to stem.nontips.
+ */
+
+/****
+ * NULL on error
+ ***************************************************************************/
+static char **allocateNonTips(long nontips, long maxlength)
+/* Like in loadNonTips */
+{
+  long stringMaxlength = (maxlength >= 3) ? maxlength : 3;
+  char **nontip;
+  register long i;
+  nontip = (char **) malloc(nontips * sizeof(void*));
+  if (!nontip)
+  {
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return NULL;
+  }
+  *nontip = (char *) malloc((stringMaxlength+1) * nontips * sizeof(char));
+  if (!*nontip)
+  {
+    free(nontip);
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return NULL;
+  }
+  for (i = 1; i < nontips; i++)
+    nontip[i] = nontip[0] + i * (stringMaxlength + 1);
+  return nontip;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int nontipsFromPathTree(group_t *group, long *index)
+/* Replaces the path tree of the construction by the list of its paths,
+ * in the order given by index */
+{
+  long nontips = group->nontips;
+  path_t *root = group->root;
+  register long i;
+  group->maxlength = root[nontips-1].depth;
+  group->nontip = allocateNonTips(nontips, group->maxlength);
+  if (!group->nontip) return 1;
+  for (i = 0; i < nontips; i++)
+    strcpy(group->nontip[i], root[index[i]].path);
+  for (i = 1; i < nontips; i++)
+    free(root[i].path);
+  freeRoot(root);
+  group->root = NULL;
+  return 0;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int nontipsFromJenningsWords(group_t *group, JenningsWord_t **word,
+  JenningsWord_t *words)
+/* word: the sorted words; words: the block they were allocated in */
+{
+  long arrows = group->arrows;
+  long nontips = group->nontips;
+  register long i;
+  group->mintips = (arrows * (arrows + 1)) / 2;
+  group->nontip = allocateNonTips(nontips, group->maxlength);
+  if (!group->nontip) return 1;
+  for (i = 0; i < nontips; i++)
+    strcpy(group->nontip[i], word[i]->path);
+  for (i = 1; i < nontips; i++)
+    free(words[i].path);
+  free(words);
+  free(word);
+  return 0;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int saveNonTips(group_t *group)
+{
+  FILE *fp;
+  char ntpfile[MAXLINE];
+  long i;
+  strext(ntpfile, group->stem, ".nontips");
+  fp = fopen(ntpfile, "w");
+  if (!fp)
+  { MTX_ERROR1("Cannot open file %s", ntpfile);
+    return 1;
+  }
+  fprintf (fp, "%ld %ld %ld %ld %ld %c\n", group->arrows, group->nontips,
+    group->maxlength, group->mintips, group->p, group->ordering);
+  for (i = 0; i < group->nontips; i++)
+    fprintf(fp, "%s;\n", group->nontip[i]);
+  fclose(fp);
+  return 0;
+}
+
+/******************************************************************************/
+static path_t *rightFactor(path_t *root, path_t *parent, long *aa)
+/* Know parent has length >= 1 */
+{
+  path_t *p;
+  long pl = parent->depth;
+  long i;
+  if (pl > MAXLENGTH)
+  {
+    MTX_ERROR1(
+      "Path of length > %d found. Increase value of MAXLENGTH in pcommon.h",
+      MAXLENGTH);
+    return NULL;
+  }
+  for (p = parent, i = pl; i >= 2; i--, p = p->parent)
+    aa[i-2] = p->lastArrow;
+  for (i = 0, p = root; i < pl - 1; p = p->child[aa[i++]]);
+  return p;
+}
+
+/*****
+ * 1 on error
+ **************************************************************************/
+int constructNontips_LengthLex(group_t *group)
+/* group->root must be allocated, group->action must be the regular action */
+{
+  long arrows = group->arrows;
+  long nontips = group->nontips;
+  path_t *root = group->root;
+  Matrix_t **action = group->action;
+  char newname;
+  long aa[MAXLENGTH];
+  long *index;
+  Matrix_t *ptr = MatAlloc(FfOrder, nontips+1, FfNoc);
+  Matrix_t *rec = MatAlloc(FfOrder, nontips+1, FfNoc);
+
+  PTR rec_parent, rec_child, ptr_child;
+  long pl, prev_starts, this_starts, so_far, mintips;
+  long i, a;
+  path_t *p, *parent, *q;
+  FEL f;
+  index = (long *) malloc(nontips * sizeof(long));
+  if (!ptr || !index || !rec)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  FfInsert(ptr->Data,0,FF_ONE);
+  FfInsert(rec->Data,0,FF_ONE);
+  if (!(ptr->PivotTable = NREALLOC(ptr->PivotTable, int, ptr->Noc)))
+    {
+        MTX_ERROR1("Cannot allocate pivot table (size %d)",ptr->Noc);
+        return -1;
+    }
+  ptr->PivotTable[0] = 0;
+  this_starts = 0; so_far = 1; mintips = 0;
+  for (pl = 1; so_far > this_starts; pl++)
+  {
+    prev_starts = this_starts;
+    this_starts = so_far;
+    for (i = prev_starts; i < this_starts; i++)
+    {
+      parent = root + i;
+      rec_parent = MatGetPtr(rec, parent->index);
+      if (pl > 1)
+      {
+        /* parent has length >= 1, so factors as b.q, b arrow, q path
+           for each a want to check if q.a reduces */
+        q = rightFactor(root, parent, aa);
+        if (!q) return 1;
+      }
+      for (a = 0; a < arrows; a++)
+      {
+        if (pl > 1 && q->child[a] == NULL) continue;
+        rec_child = MatGetPtr(rec, so_far);
+        ptr_child = MatGetPtr(ptr, so_far);
+        FfMapRow(rec_parent, action[a]->Data, nontips, rec_child);
+        memcpy(ptr_child, rec_child, FfCurrentRowSize);
+        FfCleanRow(ptr_child, ptr->Data, so_far, ptr->PivotTable);
+        ptr->PivotTable[so_far] = FfFindPivot(ptr_child, &f);
+        if (ptr->PivotTable[so_far] == -1)
+        {
+          /* New mintip found */
+          mintips++;
+        }
+        else
+        {
+          /* New nontip found */
+          p = root + so_far;
+          p->parent = parent;
+          p->lastArrow = a;
+          p->depth = pl;
+          parent->child[a] = p;
+          p->path = (char *) malloc((pl+1) * sizeof(char));
+          if (!p->path)
+          { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+            return 1;
+          }
+          if (pl > 1) strcpy(p->path, parent->path);
+          newname = arrowName(a);
+          if (newname == ' ') return 1;
+          p->path[pl-1] = newname;
+          p->path[pl] = '\0';
+          so_far++;
+        }
+      }
+    }
+  }
+  MatFree(ptr);
+  MatFree(rec);
+  for (i = 0; i < nontips; i++) index[i] = i;
+  group->mintips = mintips;
+  if (nontipsFromPathTree(group, index)) return 1;
+  free(index);
+  return 0;
+}
+
+/*****
+ * 1 on error
+ **************************************************************************/
+int constructNontips_ReverseLengthLex(group_t *group)
+/* group->root must be allocated, group->action must be the regular action */
+{
+  long nontips = group->nontips;
+  long arrows = group->arrows;
+  path_t *root = group->root;
+  Matrix_t **action = group->action;
+  long aa[MAXLENGTH];
+  long *index;
+  char newname;
+  PTR rec_parent, rec_child, ptr_child;
+  Matrix_t *rad;
+  PTR dest;
+  Matrix_t *rec;
+  long pl, prev_starts, this_starts, so_far, mintips;
+  long i, a, raddim, offset;
+  path_t *p, *parent, *q;
+  FEL f;
+  index = (long *) malloc(nontips * sizeof(long));
+  rad = MatAlloc(FfOrder, nontips * arrows, FfNoc);
+  rec = MatAlloc(FfOrder, nontips + 1, FfNoc);
+  if (!index || !rad || !rec)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  memcpy(rad->Data, action[0]->Data, (rad->RowSize*arrows * nontips));
+  if ((raddim = MatEchelonize(rad))<0) return 1;
+
+  /* Below, we will stack the images of rad under action of arrows.
+   * For that purpose, we need some scratch space.
+   */
+  PTR scratch = FfAlloc(arrows * nontips);
+  if (!scratch)
+  { MTX_ERROR1("%E",MTX_ERR_NOMEM);
+    return 1;
+  }
+
+  index[0] = 0;
+  FfInsert(rec->Data,0,FF_ONE);
+  this_starts = 0; so_far = 1; mintips = 0;
+  for (pl = 1; so_far > this_starts; pl++)
+  {
+    prev_starts = this_starts;
+    this_starts = so_far;
+    if (raddim > 0)
+    {
+      for (a = 0, dest = scratch; a < arrows; a++, dest = FfGetPtr(dest, raddim))
+      { if (innerRightProduct(rad, action[a], dest)) return 1; }
+      /* now, for the next round, transfer the scratch space to rad->Data,
+       * so that we can newly echelonise.
+       */
+      rad->Nor = arrows*raddim;
+      rad->Data = SysRealloc(rad->Data, rad->RowSize*rad->Nor);
+      if (!rad->Data)
+      {
+          MTX_ERROR1("%E", MTX_ERR_NOMEM);
+          return 1;
+      }
+      memcpy(rad->Data, scratch, rad->RowSize*rad->Nor);
+      raddim = MatEchelonize(rad);
+    }
+    /* In the following loop, we will append up to
+     * (this_starts-prev_starts)*arrows rows. Hence,
+     * we need to reallocate.
+     */
+    rad->Data = SysRealloc(rad->Data, rad->RowSize*(raddim + (this_starts-prev_starts)*arrows));
+    for (i = prev_starts; i < this_starts; i++)
+    {
+      parent = root + i;
+      rec_parent = MatGetPtr(rec, parent->index);
+      if (pl > 1)
+      {
+        /* parent has length >= 1, so factors as b.q, b arrow, q path
+           for each a want to check if q.a reduces */
+        q = rightFactor(root, parent, aa);
+        if (!q) return 1;
+      }
+      for (a = arrows-1; a >= 0; a--)
+      {
+        if (pl > 1 && q->child[a] == NULL) continue;
+        offset = raddim + so_far - this_starts;
+        rec_child = MatGetPtr(rec, so_far);
+        ptr_child = MatGetPtr(rad, offset);
+        FfMapRow(rec_parent, action[a]->Data, nontips, rec_child);
+        memcpy(ptr_child, rec_child, FfCurrentRowSize);
+        FfCleanRow(ptr_child, rad->Data, offset, rad->PivotTable);
+        rad->PivotTable[offset] = FfFindPivot(ptr_child, &f);
+        rad->Nor = offset+1;
+        if (rad->PivotTable[offset] == -1)
+        {
+          /* New mintip found */
+          mintips++;
+        }
+        else
+        {
+          /* New nontip found */
+          p = root + so_far;
+          p->parent = parent;
+          p->lastArrow = a;
+          p->depth = pl;
+          parent->child[a] = p;
+          p->path = (char *) malloc((pl+1) * sizeof(char));
+          if (!p->path)
+          { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+            return 1;
+          }
+          if (pl > 1) strcpy(p->path, parent->path);
+          newname = arrowName(a);
+          if (newname==' ') return 1;
+          p->path[pl-1] = newname;
+          p->path[pl] = '\0';
+          so_far++;
+        }
+      }
+    }
+    for (i = this_starts; i < so_far; i++)
+      index[i] = so_far - 1 - i + this_starts;
+  }
+  free(scratch);
+  MatFree(rad);
+  MatFree(rec);
+  group->mintips = mintips;
+  if (nontipsFromPathTree(group, index)) return 1;
+  free(index);
+  return 0;
+}
+
+/******************************************************************************/
+static void swapJenningsWords(JenningsWord_t **word, long i1, long i2)
+{
+  JenningsWord_t *tmp = word[i1];
+  word[i1] = word[i2];
+  word[i2] = tmp;
+  return;
+}
+
+/******************************************************************************/
+static void sortJenningsWords(group_t *group, JenningsWord_t **word)
+{
+  long gap, i, j;
+  long nontips = group->nontips;
+  for (gap = nontips/2; gap > 0; gap /= 2)
+    for (i = gap; i < nontips; i++)
+      for (j = i - gap; j >= 0 && smallerJenningsWord(word[j], word[j+gap]);
+           j -= gap)
+        swapJenningsWords(word, j, j+gap);
+  return;
+}
+
+/****
+ * NULL on error
+ ***************************************************************************/
+static char *newPath(long a, char *prev)
+{
+  char *this;
+  long l = strlen(prev) + 2;
+  if (prev[0] == '(') l = 2; /* prev is (1), length zero */
+  this = (char *) malloc(l * sizeof(char));
+  if (!this)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return NULL;
+  }
+  this[0] = arrowName(a);
+  if (this[0]==' ') return NULL;
+  this[1] = '\0';
+  if (l > 2) strcat(this,prev);
+  return this;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int constructNontips_Jennings(group_t *group)
+/* Reads stem.dims unless group->dim is set */
+{
+  long arrows, nontips;
+  long lastTime, *dim;
+  long p = group->p;
+  long i, a, offset, j;
+  JenningsWord_t **word, *words, *w, *parent;
+  if (!group->dim && loadDimensions(group)) return 1;
+  dim = group->dim;
+  arrows = dim[0];
+  group->arrows = arrows;
+  for (nontips = 1, i = 0; i < arrows; nontips *= p, i++);
+  group->nontips = nontips;
+  FfSetNoc(nontips);
+  group->maxlength = (p-1) * arrows;
+  word = (JenningsWord_t **)
+    malloc(nontips * sizeof(JenningsWord_t *));
+  words = (JenningsWord_t *)
+    malloc(nontips * sizeof(JenningsWord_t));
+  if (!words || !word)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  for (i = 0, w = words; i < nontips; i++, w++)
+    word[i] = w;
+  word[0]->path = "(1)";
+  word[0]->length = 0;
+  word[0]->dimension = 0;
+  lastTime = 1;
+  for (a = 0, lastTime = 1; a < arrows; a++, lastTime *= p)
+  {
+    for (i = 0, offset = 0; i < p-1; i++, offset += lastTime)
+    {
+      for (j = 0; j < lastTime; j++)
+      {
+        parent = word[j + offset];
+        w = word[j + offset + lastTime];
+        w->path = newPath(a, parent->path);
+        if (!w->path) return 1;
+        w->length = parent->length + 1;
+        w->dimension = parent->dimension + dim[a+1];
+      }
+    }
+  }
+  sortJenningsWords(group, word);
+  return nontipsFromJenningsWords(group, word, words);
+}
+
+/******************************************************************************
+ * Building group records in memory
+ *
+ * buildGroupRecord does in one pass what makeNontips and makeActionMatrices
+ * do with several files, starting from the regular permutation action.
+ * The right and left action matrices of different arrows are computed by
+ * different threads, using FfMapRow only (compare productWorker in slice.c).
+ */
+
+typedef struct
+{
+  group_t *group;
+  long first, last; /* arrows of this share */
+  PTR scratch;      /* nontips rows */
+} arrowShare_t;
+
+/******************************************************************************/
+static void *rightActionWorker(void *arg)
+/* action = bw * action * wb, i.e., change from the basis of group elements
+ * to the basis of nontips, see innerBasisChangeReg2Nontips */
+{
+  arrowShare_t *share = (arrowShare_t *) arg;
+  group_t *group = share->group;
+  fieldContext_t *fc = &group->fc;
+  long nontips = group->nontips;
+  PTR bw = group->bch[0]->Data, wb = group->bch[1]->Data, mat;
+  register long a, i;
+  for (a = share->first; a < share->last; a++)
+  {
+    mat = group->action[a]->Data;
+    for (i = 0; i < nontips; i++)
+      FfMapRow(rowPtr(fc, bw, i), mat, nontips, rowPtr(fc, share->scratch, i));
+    for (i = 0; i < nontips; i++)
+      FfMapRow(rowPtr(fc, share->scratch, i), wb, nontips, rowPtr(fc, mat, i));
+  }
+  return NULL;
+}
+
+/******************************************************************************/
+static void *leftActionWorker(void *arg)
+/* Like makeLeftActionMatrices. Requires the right action matrices wrt
+ * the basis of nontips */
+{
+  arrowShare_t *share = (arrowShare_t *) arg;
+  group_t *group = share->group;
+  register long a;
+  for (a = share->first; a < share->last; a++)
+  {
+    memset(share->scratch, 0, group->fc.rowSize);
+    FfInsert(share->scratch, group->root->child[a]->index, FF_ONE);
+    buildLeftActionMatrix(group, share->scratch, group->laction[a]->Data);
+  }
+  return NULL;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int runArrowShares(void *(*worker)(void *), group_t *group,
+  long threads)
+/* Distributes the arrows over the threads. If a thread can not be
+ * started, its share is done by the master thread. */
+{
+  arrowShare_t share[MAX_WORKER_THREADS];
+  pthread_t tid[MAX_WORKER_THREADS];
+  boolean started[MAX_WORKER_THREADS];
+  long arrows = group->arrows;
+  long chunk;
+  register long t;
+  if (threads > arrows) threads = arrows;
+  if (threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+  if (threads < 1) threads = 1;
+  chunk = (arrows + threads - 1) / threads;
+  for (t = 0; t < threads; t++)
+  {
+    share[t].group = group;
+    share[t].first = (t * chunk < arrows) ? t * chunk : arrows;
+    share[t].last = ((t+1) * chunk < arrows) ? (t+1) * chunk : arrows;
+    share[t].scratch = FfAlloc(group->nontips);
+    started[t] = false;
+    if (!share[t].scratch)
+    {
+      while (t--) free(share[t].scratch);
+      MTX_ERROR1("%E", MTX_ERR_NOMEM);
+      return 1;
+    }
+  }
+  for (t = 1; t < threads; t++)
+    started[t] = !pthread_create(tid + t, NULL, worker, share + t);
+  worker(share);
+  for (t = 1; t < threads; t++)
+  {
+    if (started[t]) pthread_join(tid[t], NULL);
+    else worker(share + t);
+  }
+  for (t = 0; t < threads; t++)
+    free(share[t].scratch);
+  return 0;
+}
+
+/****
+ * 1 on error
+ *
+ * group must have stem, p, ordering, arrows and nontips set, and dim in
+ * the Jennings case. perm[a*nontips+j] is the image of the group element
+ * j+1 under the a-th generator in the regular permutation action, as in
+ * the .reg files. Afterwards, group is as returned by fullyLoadedGroupRecord,
+ * and in addition has the basis change matrices. Nothing is written
+ * to disk.
+ ***************************************************************************/
+int buildGroupRecord(group_t *group, const long *perm, long threads)
+{
+  setFieldContext(&group->fc, group->p, group->nontips);
+  group->action = allocateActionMatrices(group);
+  if (!group->action) return 1;
+  setRegularActionMatrices(group, group->action, perm, group->arrows);
+  switch (group->ordering)
+  {
+  case 'R' :
+    group->root = allocatePathTree(group);
+    if (!group->root) return 1;
+    if (constructNontips_ReverseLengthLex(group)) return 1;
+    break;
+  case 'J' :
+    if (constructNontips_Jennings(group)) return 1;
+    break;
+  case 'L' :
+    MTX_ERROR("can't cope with LL ordering");
+    return 1;
+  default :
+    MTX_ERROR("not implemented for this ordering");
+    return 1;
+  }
+  if (buildPathTree(group)) return 1;
+  if (buildLeftPathTree(group)) return 1;
+  if (markPathDimensions(group)) return 1;
+  if (makeBasisChangeMatrices(group)) return 1;
+  if (runArrowShares(rightActionWorker, group, threads)) return 1;
+  group->laction = allocateActionMatrices(group);
+  if (!group->laction) return 1;
+  if (runArrowShares(leftActionWorker, group, threads)) return 1;
+  return calculateDimSteps(group);
+}
+
 /******************************************************************************/
 long pathTreeGirth(group_t *group)
 {
@@ -1593,6 +2564,327 @@ int calculateDimSteps(group_t *group)
   return 0;
 }
 
+/******************************************************************************
+ * Binary snapshots of group records
+ *
+ * loadNonTips, buildPathTree, buildLeftPathTree, loadActionMatrices,
+ * loadLeftActionMatrices and calculateDimSteps are replaced by one look
+ * at the file stem.snap, which contains everything fullyLoadedGroupRecord
+ * creates. The text and matrix files remain the source of truth: the
+ * snapshot records their sizes and modification times and is ignored if
+ * one of them changed.
+ * The snapshot is in native byte order and only valid for the MeatAxe
+ * that wrote it, which is granted by checking the row size.
+ */
+
+#define SNAPSHOT_MAGIC 0x70477350L
+#define SNAPSHOT_VERSION 1L
+#define SNAPSHOT_SOURCES 4
+
+static char *snapshotSourceExt[SNAPSHOT_SOURCES] =
+  {".nontips", ".dims", ".gens", ".lgens"};
+
+typedef struct
+{
+  long size;  /* -1 if the file does not exist */
+  long mtime;
+} snapshotSource_t;
+
+typedef struct
+{
+  long magic;
+  long version;
+  long longSize;
+  long arrows, nontips, maxlength, mintips, p, ordering;
+  long stringLength;   /* bytes per nontip, including '\0' */
+  long dims;           /* number of longs in group->dim, 0 if none */
+  long dSLength;       /* number of longs in group->dS */
+  long rowSize;        /* FfCurrentRowSize for nontips columns */
+  snapshotSource_t src[SNAPSHOT_SOURCES];
+} snapshotHeader_t;
+
+/******************************************************************************/
+static inline size_t snapshotPadded(size_t n)
+{
+  return (n + sizeof(long) - 1) & ~(sizeof(long) - 1);
+}
+
+/******************************************************************************/
+static void snapshotSources(char *stem, snapshotSource_t *src)
+{
+  char name[MAXLINE];
+  struct stat st;
+  int k;
+  for (k = 0; k < SNAPSHOT_SOURCES; k++)
+  {
+    strext(name, stem, snapshotSourceExt[k]);
+    if (stat(name, &st))
+    {
+      src[k].size = -1;
+      src[k].mtime = 0;
+    }
+    else
+    {
+      src[k].size = (long) st.st_size;
+      src[k].mtime = (long) st.st_mtime;
+    }
+  }
+}
+
+/******************************************************************************/
+static long dimStepsLength(group_t *group)
+{
+  long d;
+  if (group->ordering == 'R') return group->maxlength + 3;
+  for (d = 0; group->dS[d] < group->nontips; d++);
+  return d + 1;
+}
+
+/******************************************************************************/
+static int writeSnapshotPadding(FILE *fp, size_t n)
+/* Pads a block of n bytes to a multiple of sizeof(long) */
+{
+  static const char zeros[sizeof(long)] = {0};
+  size_t pad = snapshotPadded(n) - n;
+  if (pad && fwrite(zeros, 1, pad, fp) != pad) return 1;
+  return 0;
+}
+
+/******************************************************************************/
+static int writeSnapshotBlock(FILE *fp, const void *data, size_t n)
+{
+  if (n && fwrite(data, 1, n, fp) != n) return 1;
+  return writeSnapshotPadding(fp, n);
+}
+
+/******************************************************************************/
+static int writeSnapshotTree(FILE *fp, group_t *group, path_t *root)
+/* Per node: parent index, last arrow, depth and dim; then the children */
+{
+  long nontips = group->nontips, arrows = group->arrows;
+  long i, a, node[4];
+  int32_t c;
+  for (i = 0; i < nontips; i++)
+  {
+    node[0] = (root[i].parent) ? root[i].parent->index : -1;
+    node[1] = (i) ? root[i].lastArrow : -1;
+    node[2] = root[i].depth;
+    node[3] = root[i].dim;
+    if (fwrite(node, sizeof(long), 4, fp) != 4) return 1;
+  }
+  for (i = 0; i < nontips; i++)
+    for (a = 0; a < arrows; a++)
+    {
+      c = (root[i].child[a]) ? (int32_t) root[i].child[a]->index : -1;
+      if (fwrite(&c, sizeof(int32_t), 1, fp) != 1) return 1;
+    }
+  return writeSnapshotPadding(fp, nontips * arrows * sizeof(int32_t));
+}
+
+/****
+ * 1 on error
+ *
+ * Writes the snapshot of a group record, as created by fullyLoadedGroupRecord.
+ * The file is written under a temporary name and then renamed, so that
+ * concurrent readers never see an incomplete snapshot. No MeatAxe error is
+ * raised, since the group data can always be read from the text files.
+ ***************************************************************************/
+int saveGroupSnapshot(group_t *group)
+{
+  char name[MAXLINE], tmpname[MAXLINE+24];
+  snapshotHeader_t head;
+  FILE *fp;
+  long i;
+  size_t chunk, stringLength;
+  int err = 0;
+  if (!group->nontip || !group->root || !group->lroot || !group->action ||
+      !group->laction || !group->dS) return 1;
+  stringLength = (group->nontips > 1) ?
+    (size_t) (group->nontip[1] - group->nontip[0]) :
+    (size_t) (((group->maxlength >= 3) ? group->maxlength : 3) + 1);
+  memset(&head, 0, sizeof(head));
+  head.magic = SNAPSHOT_MAGIC;
+  head.version = SNAPSHOT_VERSION;
+  head.longSize = sizeof(long);
+  head.arrows = group->arrows;
+  head.nontips = group->nontips;
+  head.maxlength = group->maxlength;
+  head.mintips = group->mintips;
+  head.p = group->p;
+  head.ordering = group->ordering;
+  head.stringLength = stringLength;
+  head.dims = (group->dim) ? group->dim[0] + 1 : 0;
+  head.dSLength = dimStepsLength(group);
+  head.rowSize = group->fc.rowSize;
+  snapshotSources(group->stem, head.src);
+  strext(name, group->stem, ".snap");
+  snprintf(tmpname, sizeof(tmpname), "%s.%ld", name, (long) getpid());
+  fp = fopen(tmpname, "wb");
+  if (!fp) return 1;
+  chunk = group->nontips * group->fc.rowSize;
+  err = writeSnapshotBlock(fp, &head, sizeof(head))
+    || writeSnapshotBlock(fp, group->nontip[0], group->nontips * stringLength)
+    || writeSnapshotTree(fp, group, group->root)
+    || writeSnapshotTree(fp, group, group->lroot)
+    || writeSnapshotBlock(fp, group->dim, head.dims * sizeof(long))
+    || writeSnapshotBlock(fp, group->dS, head.dSLength * sizeof(long));
+  for (i = 0; !err && i < group->arrows; i++)
+    err = writeSnapshotBlock(fp, group->action[i]->Data, chunk);
+  for (i = 0; !err && i < group->arrows; i++)
+    err = writeSnapshotBlock(fp, group->laction[i]->Data, chunk);
+  if (fclose(fp)) err = 1;
+  if (!err) err = rename(tmpname, name);
+  if (err) unlink(tmpname);
+  return (err) ? 1 : 0;
+}
+
+/******************************************************************************/
+static void restoreSnapshotTree(group_t *group, path_t *root,
+  const long *node, const int32_t *child)
+{
+  long nontips = group->nontips, arrows = group->arrows;
+  long i, a;
+  for (i = 0; i < nontips; i++, node += 4)
+  {
+    root[i].parent = (node[0] >= 0) ? root + node[0] : NULL;
+    root[i].lastArrow = node[1];
+    root[i].depth = node[2];
+    root[i].dim = node[3];
+    if (i) root[i].path = group->nontip[i];
+  }
+  for (i = 0; i < nontips; i++)
+    for (a = 0; a < arrows; a++, child++)
+      root[i].child[a] = (*child >= 0) ? root + *child : NULL;
+}
+
+/******************************************************************************/
+static void clearGroupRecord(group_t *group)
+/* Frees all data but the stem, after a failed loadGroupSnapshot */
+{
+  if (group->nontip) freeNonTips(group->nontip);
+  if (group->root) freeRoot(group->root);
+  if (group->lroot) freeRoot(group->lroot);
+  if (group->action) freeActionMatrices(group->action);
+  if (group->laction) freeActionMatrices(group->laction);
+  if (group->dim) free(group->dim);
+  if (group->dS) free(group->dS);
+  if (group->pathDepth) free(group->pathDepth);
+  if (group->pathChild) free(group->pathChild);
+  group->nontip = NULL;
+  group->root = group->lroot = NULL;
+  group->action = group->laction = NULL;
+  group->dim = group->dS = NULL;
+  group->pathDepth = NULL;
+  group->pathChild = NULL;
+}
+
+/******************************************************************************/
+static int readGroupSnapshot(group_t *group, const char *data, size_t len)
+{
+  const snapshotHeader_t *head = (const snapshotHeader_t *) data;
+  snapshotSource_t src[SNAPSHOT_SOURCES];
+  const char *pos = data;
+  size_t stringLength, treeSize, chunk, need;
+  long nontips, arrows, i;
+  if (len < sizeof(snapshotHeader_t)) return 1;
+  if (head->magic != SNAPSHOT_MAGIC || head->version != SNAPSHOT_VERSION
+      || head->longSize != sizeof(long)) return 1;
+  snapshotSources(group->stem, src);
+  if (memcmp(src, head->src, sizeof(src))) return 1;  /* stale */
+  nontips = head->nontips;
+  arrows = head->arrows;
+  if (nontips < 1 || arrows < 1 || arrows > MAXARROW) return 1;
+  group->arrows = arrows;
+  group->nontips = nontips;
+  group->maxlength = head->maxlength;
+  group->mintips = head->mintips;
+  group->p = head->p;
+  group->ordering = (char) head->ordering;
+  setFieldContext(&group->fc, group->p, nontips);
+  if ((long) group->fc.rowSize != head->rowSize) return 1;
+  stringLength = head->stringLength;
+  treeSize = nontips * 4 * sizeof(long)
+    + snapshotPadded(nontips * arrows * sizeof(int32_t));
+  chunk = nontips * group->fc.rowSize;
+  need = snapshotPadded(sizeof(snapshotHeader_t))
+    + snapshotPadded(nontips * stringLength) + 2 * treeSize
+    + (head->dims + head->dSLength) * sizeof(long)
+    + 2 * arrows * snapshotPadded(chunk);
+  if (len != need) return 1;
+  pos += snapshotPadded(sizeof(snapshotHeader_t));
+
+  group->nontip = (char **) malloc(nontips * sizeof(void*));
+  if (!group->nontip) return 1;
+  *group->nontip = (char *) malloc(nontips * stringLength);
+  if (!*group->nontip)
+  { free(group->nontip);
+    group->nontip = NULL;
+    return 1;
+  }
+  memcpy(*group->nontip, pos, nontips * stringLength);
+  for (i = 1; i < nontips; i++)
+    group->nontip[i] = group->nontip[0] + i * stringLength;
+  pos += snapshotPadded(nontips * stringLength);
+
+  if (!(group->root = allocatePathTree(group))) return 1;
+  restoreSnapshotTree(group, group->root, (const long *) pos,
+    (const int32_t *) (pos + nontips * 4 * sizeof(long)));
+  pos += treeSize;
+  if (!(group->lroot = allocatePathTree(group))) return 1;
+  restoreSnapshotTree(group, group->lroot, (const long *) pos,
+    (const int32_t *) (pos + nontips * 4 * sizeof(long)));
+  pos += treeSize;
+  if (flattenPathTree(group)) return 1;
+
+  if (head->dims)
+  {
+    if (!(group->dim = (long *) malloc(head->dims * sizeof(long)))) return 1;
+    memcpy(group->dim, pos, head->dims * sizeof(long));
+    pos += head->dims * sizeof(long);
+  }
+  if (!(group->dS = (long *) malloc(head->dSLength * sizeof(long)))) return 1;
+  memcpy(group->dS, pos, head->dSLength * sizeof(long));
+  pos += head->dSLength * sizeof(long);
+
+  if (!(group->action = allocateActionMatrices(group))) return 1;
+  for (i = 0; i < arrows; i++, pos += snapshotPadded(chunk))
+    memcpy(group->action[i]->Data, pos, chunk);
+  if (!(group->laction = allocateActionMatrices(group))) return 1;
+  for (i = 0; i < arrows; i++, pos += snapshotPadded(chunk))
+    memcpy(group->laction[i]->Data, pos, chunk);
+  return 0;
+}
+
+/****
+ * 1 if the snapshot does not exist, is stale or can not be read
+ *
+ * Fills group, which only needs to have its stem set, from the snapshot
+ * stem.snap. No MeatAxe error is raised; the caller is supposed to read
+ * the text files instead if 1 is returned. Then, the group record
+ * is as before.
+ ***************************************************************************/
+int loadGroupSnapshot(group_t *group)
+{
+  char name[MAXLINE];
+  struct stat st;
+  void *data;
+  int fd, err;
+  strext(name, group->stem, ".snap");
+  fd = open(name, O_RDONLY);
+  if (fd < 0) return 1;
+  if (fstat(fd, &st) || st.st_size <= 0)
+  { close(fd);
+    return 1;
+  }
+  data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return 1;
+  err = readGroupSnapshot(group, (const char *) data, st.st_size);
+  munmap(data, st.st_size);
+  if (err) clearGroupRecord(group);
+  return err;
+}
+
 /****
  * NULL on error
  ***************************************************************************/
@@ -1600,6 +2892,7 @@ group_t *fullyLoadedGroupRecord(char *stem)
 {
   group_t *G = namedGroupRecord(stem);
   if (!G) return NULL;
+  if (!loadGroupSnapshot(G)) return G;
   if (loadNonTips(G))
   { freeGroupRecord(G);
     return NULL;
@@ -1639,6 +2932,7 @@ group_t *fullyLoadedGroupRecord(char *stem)
   { freeGroupRecord(G);
     return NULL;
   }
+  saveGroupSnapshot(G); /* failure only means that the text files are read next time */
   return G;
 }
 
@@ -50,6 +50,60 @@ struct pathnode
   long dim;   /* Dimension of path, for Jennings case */
 };
 
+/* Wide kernels.
+ * On x86_64 Linux, gcc compiles functions marked WIDE_KERNEL for AVX-512,
+ * AVX2 and a default target, and the dynamic linker selects the version
+ * supported by the CPU. Elsewhere, the vector extension is mapped to
+ * SSE2/NEON or to scalar code.
+ */
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__) && !defined(__clang__)
+#define WIDE_KERNEL __attribute__ ((target_clones("avx512f","avx2","default")))
+#else
+#define WIDE_KERNEL
+#endif
+
+#if defined(__GNUC__)
+typedef unsigned long wideLong_t __attribute__ ((vector_size (4*sizeof(long))));
+#endif
+
+/* Field and row geometry of vectors with noc entries. The MeatAxe keeps
+ * the current field and row size in global variables. Rows are addressed
+ * by means of a fieldContext_t instead, and the MeatAxe is only reset if
+ * its current field differs, see activateFieldContext */
+typedef struct
+{
+  long fl;          /* field order */
+  long noc;         /* number of columns */
+  size_t rowSize;   /* bytes of a row in memory */
+  size_t rowSizeIo; /* bytes of a row in a file */
+} fieldContext_t;
+
+/******************************************************************************/
+static inline void selectField(long fl, long noc)
+/* Like FfSetField(fl); FfSetNoc(noc), but only where needed */
+{
+  if (FfOrder != fl)
+  {
+    FfSetField(fl);
+    FfSetNoc(noc);
+  }
+  else if (FfNoc != noc)
+    FfSetNoc(noc);
+}
+
+/******************************************************************************/
+static inline void activateFieldContext(const fieldContext_t *fc)
+{
+  selectField(fc->fl, fc->noc);
+}
+
+/******************************************************************************/
+static inline PTR rowPtr(const fieldContext_t *fc, PTR base, long row)
+/* Like FfGetPtr, but independent of the current row size of the MeatAxe */
+{
+  return (PTR) ((char *) base + row * fc->rowSize);
+}
+
 struct groupRecord
 {
   char *stem;
@@ -67,6 +121,13 @@ struct groupRecord
   Matrix_t **bch;
   long *dim;
   long *dS;           /* depth Steps: for resolution only */
+  int32_t *pathDepth; /* depth of the nontips in root, see flattenPathTree */
+  int32_t *pathChild; /* pathChild[i*arrows+a] is the index of the child
+                         of nontip i by arrow a in root, or -1 */
+  PTR *rcache;        /* right action matrices of the nontips, or NULL */
+  PTR *lcache;        /* left action matrices of the nontips, or NULL */
+  long cacheLimit, cacheBytes, cacheHits, cacheMisses;
+  fieldContext_t fc;  /* vectors of length nontips over GF(p) */
 };
 
 typedef struct groupRecord group_t;
@@ -76,6 +76,8 @@ extern void freeNonTips(char **nontip);
 
 path_t *allocatePathTree(group_t *group);
 int buildPathTree(group_t *group);
+void setFieldContext(fieldContext_t *fc, long fl, long noc);
+int flattenPathTree(group_t *group);
 int buildLeftPathTree(group_t *group);
 extern void freeRoot(path_t *root);
 
@@ -90,6 +92,7 @@ Matrix_t **allocateMatrixList(group_t *group, long num);
 extern Matrix_t **allocateActionMatrices(group_t *group);
 extern void freeMatrixList(Matrix_t **mat);
 extern void freeActionMatrices(Matrix_t **mat);
+void xorLongs(long *dest, const long *src, long n);
 void FfAddMapRow(PTR row, PTR matrix, int nor, PTR result);
 
 char *mtx_strdup(const char *src);
@@ -107,12 +110,18 @@ Matrix_t *InnerRightAction(Matrix_t *dest, const Matrix_t *src, PTR scratch);
 Matrix_t *InnerLeftAction(const Matrix_t *src, Matrix_t *dest, PTR scratch);
 /* Guaranteed not to alter pointer dest->Data */
 void innerLeftActionMatrix(group_t *group, PTR vec, PTR dest);
+int enableActionMatrixCache(group_t *group, long bytes);
+void disableActionMatrixCache(group_t *group);
+void actionMatrixCacheStatistics(group_t *group, long *bytes, long *hits,
+  long *misses);
 extern Matrix_t *leftActionMatrix(group_t *group, PTR vec);
 void innerRightActionMatrix(group_t *group, PTR vec, PTR dest);
 extern Matrix_t *rightActionMatrix(group_t *group, PTR vec);
 extern int loadActionMatrices(group_t *group);
 extern int loadLeftActionMatrices(group_t *group);
 
+void setRegularActionMatrices(group_t *group, Matrix_t **action,
+  const long *perm, long num);
 int loadGeneralRegularActionMatrices(group_t *group, Matrix_t **action,
   char *name, long nor);
 int loadRegularActionMatrices(group_t *group);
@@ -123,8 +132,8 @@ int readRegFileHeader(group_t *group);
 
 int convertPermutationsToAsci(const char *infile, const char *outfile);
 
-void innerRightCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
-  long q, PTR scratch, PTR gamma);
+int innerRightCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
+  long q, PTR gamma);
 /* alpha: matrix representing map from free rk s to free rk r
    beta : free rk r to free rk q
    free = free RIGHT G-module
@@ -132,9 +141,15 @@ void innerRightCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
    Then gamma s * q rows
    gamma_{ki} = \sum_{j=1}^r beta_{kj} alpha_{ji}
    gamma must be initialised before calling innerCompose
-   scratch: scratch space, nontips+1 rows
    Right: use right action matrix of alpha_ji
 */
+int innerRightComposeMany(group_t *group, PTR alpha, long s, long r, long n,
+  PTR *beta, long *q, PTR *gamma);
+/* As innerRightCompose, for n maps beta[m] from free rk r to free rk q[m] */
+int innerComposeChainMaps(group_t *group, PTR M1, PTR M2, long RK, long Rk,
+  long rk, PTR out);
+/* Adds the composition of M1 (free rk RK -> rk Rk) and M2 (rk Rk -> rk rk)
+   to out, using right or left action matrices, whichever are fewer */
 /*void innerLeftCompose(group_t *group, PTR alpha, PTR beta, long s, long r,
   long q, PTR scratch, PTR gamma);*/
 /* alpha: matrix representing map from free rk s to free rk r
@@ -155,8 +170,16 @@ int innerBasisChangeNontips2Reg(group_t *group, Matrix_t **matlist,
 int basisChangeReg2Nontips(group_t *group, Matrix_t **matlist, long num);
 int changeActionMatricesReg2Nontips(group_t *group);
 
+int constructNontips_LengthLex(group_t *group);
+int constructNontips_ReverseLengthLex(group_t *group);
+int constructNontips_Jennings(group_t *group);
+int saveNonTips(group_t *group);
+int buildGroupRecord(group_t *group, const long *perm, long threads);
+
 long pathTreeGirth(group_t *group);
 int calculateDimSteps(group_t *group);
+int saveGroupSnapshot(group_t *group);
+int loadGroupSnapshot(group_t *group);
 group_t *fullyLoadedGroupRecord(char *stem);
 
 extern boolean fileExists(const char *name);
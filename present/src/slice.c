@@ -18,7 +18,7 @@
     along with p_group_cohomoloy.  If not, see <http://www.gnu.org/licenses/>.
 *****************************************************************************/
 /*
-*  slice.c : Methods for the disk-based slice product storage system
+*  slice.c : Methods for the slice product storage system (memory or disk)
 *  Author: David J Green
 *  First version: 16 March 2000 from urbild.c
 */
@@ -27,6 +27,7 @@
 #include "fp_decls.h"
 #include "meataxe.h"
 #include <stdio.h>
+#include <pthread.h>
 
 MTX_DEFINE_FILE_INFO
 
@@ -45,34 +46,88 @@ MTX_DEFINE_FILE_INFO
 * }
 */
 
+/****
+ * 1 on error
+ ***************************************************************************/
+int growVectorPool(ngs_t *ngs)
+/* Adds VECTOR_SLAB general, unreduced and reduced vectors to the free lists */
+{
+  register long i;
+  long nor = ngs->r + ngs->s;
+  vS_t *slab = (vS_t *) malloc(sizeof(vS_t));
+  if (!slab)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  slab->gv = (gV_t *) malloc(VECTOR_SLAB * sizeof(gV_t));
+  slab->uv = (uV_t *) malloc(VECTOR_SLAB * sizeof(uV_t));
+  slab->rv = (rV_t *) malloc(VECTOR_SLAB * sizeof(rV_t));
+  slab->rows = FfAlloc(VECTOR_SLAB * nor);
+  if (!slab->gv || !slab->uv || !slab->rv || !slab->rows)
+  {
+    if (slab->gv) free(slab->gv);
+    if (slab->uv) free(slab->uv);
+    if (slab->rv) free(slab->rv);
+    if (slab->rows) free(slab->rows);
+    free(slab);
+    MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  for (i = 0; i < VECTOR_SLAB; i++)
+  {
+    slab->gv[i].w = rowPtr(&ngs->fc, slab->rows, i * nor);
+    slab->gv[i].nextFree = ngs->freeGV;
+    ngs->freeGV = slab->gv + i;
+    slab->uv[i].next = ngs->freeUV;
+    ngs->freeUV = slab->uv + i;
+    slab->rv[i].next = ngs->freeRV;
+    ngs->freeRV = slab->rv + i;
+  }
+  slab->next = ngs->slabs;
+  ngs->slabs = slab;
+  return 0;
+}
+
+/******************************************************************************/
+void freeVectorPool(ngs_t *ngs)
+/* Releases all vectors of ngs, whether in use or not */
+{
+  vS_t *slab, *next;
+  for (slab = ngs->slabs; slab; slab = next)
+  {
+    next = slab->next;
+    free(slab->gv);
+    free(slab->uv);
+    free(slab->rv);
+    free(slab->rows);
+    free(slab);
+  }
+  ngs->slabs = NULL;
+  ngs->freeGV = NULL;
+  ngs->freeUV = NULL;
+  ngs->freeRV = NULL;
+  return;
+}
+
 /******************************************************************************/
-void freeGeneralVector(gV_t *gv)
+void freeGeneralVector(ngs_t *ngs, gV_t *gv)
+/* Returns gv to the vector pool of ngs */
 {
-  if (gv->w) free(gv->w);
-  free(gv);
+  gv->nextFree = ngs->freeGV;
+  ngs->freeGV = gv;
   return;
 }
 
 /****
  * NULL on error
  ***************************************************************************/
-inline gV_t *generalVectorTemplate(long nor)
+gV_t *pooledGeneralVector(ngs_t *ngs)
 {
   gV_t *gv;
-  PTR w;
-  gv = (gV_t *) malloc(sizeof(gV_t));
-  if (!gv)
-      {
-          MTX_ERROR1("%E", MTX_ERR_NOMEM);
-          return NULL;
-      }
-  w = FfAlloc(nor);
-  if (!w)
-      {
-          MTX_ERROR1("%E", MTX_ERR_NOMEM);
-          return NULL;
-      }
-  gv->w = w;
+  if (!ngs->freeGV && growVectorPool(ngs)) return NULL;
+  gv = ngs->freeGV;
+  ngs->freeGV = gv->nextFree;
+  gv->nextFree = NULL;
   gv->radical = true; /* "default" value */
   return gv;
 }
@@ -80,13 +135,7 @@ inline gV_t *generalVectorTemplate(long nor)
 /******************************************************************************/
 void pushGeneralVector(ngs_t *ngs, gV_t *gv)
 {
-  if (ngs->gVwaiting)
-  {
-    printf("Warning: pushGeneralVector discarding\n");
-    freeGeneralVector(gv);
-  }
-  else
-    ngs->gVwaiting = gv;
+  freeGeneralVector(ngs, gv);
   return;
 }
 
@@ -99,15 +148,13 @@ int makeVectorMonic(ngs_t *ngs, gV_t *gv)
   register long nor = ngs->r + ngs->s;
   register FEL f = gv->coeff;
   register FEL g;
-  PTR ptr;
-  register int i;
   if (f == FF_ONE) return 0;
   if (f == FF_ZERO)
   { MTX_ERROR1("%E", MTX_ERR_DIV0);
     return 1;
   }
   g = FfInv(f);
-  for (i = 0, ptr = gv->w; i < nor; i++, ptr+=FfCurrentRowSize) FfMulRow(ptr, g);
+  ngs->mulBlock(gv->w, g, nor * ngs->fc.rowSize);
   return 0;
 }
 
@@ -118,21 +165,21 @@ void findLeadingMonomial(gV_t *gv, long r, group_t *group)
   FEL coeff;
   register int b;
   register PTR ptr = gv->w;
-  path_t rootcol;
+  register long depth;
   gv->len = group->maxlength+1;
   gv->coeff = FF_ZERO;
   gv->dim = ZERO_BLOCK;
-  for (b = 0; b < r; b++, ptr+=FfCurrentRowSize)
+  for (b = 0; b < r; b++, ptr+=group->fc.rowSize)
   {
     register int col = FfFindPivot(ptr, &coeff);
     if (col != -1)
     {
-      rootcol = group->root[col];
-      if (rootcol.depth < gv->len)
+      depth = group->pathDepth[col];
+      if (depth < gv->len)
       {
-        gv->dim = rootcol.depth;
+        gv->dim = depth;
         gv->coeff = coeff;
-        gv->len = rootcol.depth;
+        gv->len = depth;
         gv->block = b;
         gv->col = col;
       }
@@ -158,8 +205,7 @@ int multiply(PTR row, Matrix_t *mat, PTR result, long r)
   //~ }
   //~ else
   { Matrix_t Row;
-    FfSetField(mat->Field);
-    FfSetNoc(mat->Noc);
+    selectField(mat->Field, mat->Noc);
     Row.Magic = mat->Magic;
     Row.Field = mat->Field;
     Row.Nor = r;
@@ -176,41 +222,37 @@ int multiply(PTR row, Matrix_t *mat, PTR result, long r)
  ***************************************************************************/
 int createWordForest(ngs_t *ngs, group_t *group)
 /* There is a separate routine to initialize */
-/* Forest contains ngs->r trees */
+/* Forest contains ngs->r trees, of the shape of group->root */
 {
-  register long i, j, k;
+  register long i;
   long nodes = group->nontips;
-  long arrows = group->arrows;
   long r = ngs->r;
   //  modW_t **proot = (modW_t **) malloc(r * sizeof(modW_t *));
   modW_t **proot = (modW_t **) malloc(r * sizeof(void*));
   modW_t *proot0 = (modW_t *) malloc(r * nodes * sizeof(modW_t));
-  //  modW_t **kinder = (modW_t **) malloc(r * arrows * nodes * sizeof(modW_t *));
-  modW_t **kinder = (modW_t **) malloc(r * arrows * nodes * sizeof(void*));
-  modW_t *node;
-  if (!proot || !proot0 || !kinder)
-    { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+  wordState_t *wstate = (wordState_t *) malloc(r * nodes * sizeof(wordState_t));
+  if (!proot || !proot0 || !wstate)
+    { if (proot) free(proot);
+      if (proot0) free(proot0);
+      if (wstate) free(wstate);
+      MTX_ERROR1("%E", MTX_ERR_NOMEM);
+      return 1;
+    }
+  if (!group->pathChild && flattenPathTree(group))
+    { free(proot); free(proot0); free(wstate);
       return 1;
     }
-  for (i = 0; i < r * arrows * nodes; i++)
-    kinder[i] = NULL;
   for (i = 0; i < r; i++)
-  {
     proot[i] = proot0 + i * nodes;
-    for (j = 0; j < nodes; j++)
-    {
-      node = proot[i] + j;
-      node->child =
-        kinder + ((i * nodes + j) * arrows);
-      node->divisor = NULL;
-      node->status = NO_DIVISOR;
-      for (k = 0; k < arrows; k++)
-        if (group->root[j].child[k] != NULL)
-          node->child[k] =
-            proot[i] + group->root[j].child[k]->index;
-    }
+  for (i = 0; i < r * nodes; i++)
+  {
+    proot0[i].parent = NULL;
+    proot0[i].divisor = NULL;
+    wstate[i].status = NO_DIVISOR;
+    wstate[i].qi = 0;
   }
   ngs->proot = proot;
+  ngs->wstate = wstate;
   return 0;
 }
 
@@ -219,7 +261,7 @@ Simon King (2008-12) this function occurs only once, hence, insert it manually
 void freeWordForest(ngs_t *ngs)
 {
   modW_t **proot = ngs->proot;
-  free(proot[0][0].child);
+  free(ngs->wstate);
   free(proot[0]);
   free(proot);
   return;
@@ -233,18 +275,20 @@ static int updateWordStatusData(ngs_t *ngs, group_t *group)
 {
   register long blo, pat, nops;
   register long dim = ngs->dimLoaded;
-  register modW_t *node;
+  register modW_t *row;
+  register wordState_t *ws;
   if (dim == NONE)
   {
       MTX_ERROR("no dimLoaded");
       return 1;
   }
   for (blo = 0, nops = 0; blo < ngs->r; blo++)
+  {
+    row = ngs->proot[blo];
+    ws = ngs->wstate + blo * group->nontips;
     for (pat = group->dS[dim]; pat < group->dS[dim+1]; pat++)
-    {
-      node = ngs->proot[blo] + pat;
-      if (node->divisor && node->qi != 0) node->status = nops++;
-    }
+      if (row[pat].divisor && ws[pat].qi != 0) ws[pat].status = nops++;
+  }
   ngs->nops = nops;
   return 0;
 }
@@ -258,11 +302,173 @@ static char *storedProductFile(ngs_t *ngs, long dim)
   return buffer;
 }
 
+/******************************************************************************/
+static sS_t *storedSlice(ngs_t *ngs, long dim)
+/* NULL if the slice of this dimension is not kept in memory */
+{
+  register sS_t *ss;
+  for (ss = ngs->slices; ss; ss = ss->next)
+    if (ss->dim == dim) return ss;
+  return NULL;
+}
+
+/******************************************************************************/
+static boolean sliceFitsInMemory(ngs_t *ngs, long rows)
+{
+  if (rows < 0 || ngs->sliceBytes >= ngs->sliceMemory) return false;
+  return ((size_t) rows <= (ngs->sliceMemory - ngs->sliceBytes) / ngs->fc.rowSize) ?
+    true : false;
+}
+
+/******************************************************************************/
+static void freeStoredSlice(ngs_t *ngs, sS_t *ss)
+{
+  sS_t **pss;
+  for (pss = &(ngs->slices); *pss; pss = &((*pss)->next))
+    if (*pss == ss)
+    {
+      *pss = ss->next;
+      break;
+    }
+  if (ngs->sliceLoaded == ss) ngs->sliceLoaded = NULL;
+  ngs->sliceBytes -= ss->rows * ngs->fc.rowSize;
+  if (ss->data) free(ss->data);
+  free(ss);
+  return;
+}
+
+/******************************************************************************/
+static void unmapCurrentDimension(ngs_t *ngs)
+{
+  if (ngs->sliceMap) unmapfileplus(ngs->sliceMap);
+  ngs->sliceMap = NULL;
+  return;
+}
+
+/******************************************************************************/
+void freeStoredSlices(ngs_t *ngs)
+/* Also releases the mapped .stp file, if any */
+{
+  while (ngs->slices) freeStoredSlice(ngs, ngs->slices);
+  unmapCurrentDimension(ngs);
+  return;
+}
+
+/******************************************************************************/
+static void invalidateBlockCache(ngs_t *ngs)
+{
+  register long k;
+  for (k = 0; k < ngs->cacheSize; k++)
+    ngs->cachedIndex[k] = NONE;
+  ngs->blockLoaded = NONE;
+  ngs->blockData = NULL;
+  return;
+}
+
+/******************************************************************************/
+void freeBlockCache(ngs_t *ngs)
+/* ngs->thisBlock, which is slot 0 of the cache, is not freed */
+{
+  register long k;
+  if (ngs->cachedBlock)
+  {
+    for (k = 1; k < ngs->cacheSize; k++)
+      if (ngs->cachedBlock[k]) free(ngs->cachedBlock[k]);
+    free(ngs->cachedBlock);
+  }
+  if (ngs->cachedIndex) free(ngs->cachedIndex);
+  if (ngs->cachedUse) free(ngs->cachedUse);
+  ngs->cachedBlock = NULL;
+  ngs->cachedIndex = NULL;
+  ngs->cachedUse = NULL;
+  ngs->cacheSize = 0;
+  return;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int setBlockCacheSize(ngs_t *ngs, long size)
+/* Number of blocks of the current dimension that are kept in memory.
+ * Slot 0 is ngs->thisBlock, the other slots are allocated on first use. */
+{
+  register long k;
+  if (size < 1) size = 1;
+  freeBlockCache(ngs);
+  ngs->cachedBlock = (PTR *) malloc(size * sizeof(PTR));
+  ngs->cachedIndex = (long *) malloc(size * sizeof(long));
+  ngs->cachedUse = (long *) malloc(size * sizeof(long));
+  if (!ngs->cachedBlock || !ngs->cachedIndex || !ngs->cachedUse)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  ngs->cacheSize = size;
+  for (k = 0; k < size; k++)
+  {
+    ngs->cachedBlock[k] = NULL;
+    ngs->cachedUse[k] = 0;
+  }
+  ngs->cachedBlock[0] = ngs->thisBlock;
+  ngs->cacheClock = 0;
+  invalidateBlockCache(ngs);
+  return 0;
+}
+
+/******************************************************************************/
+static long leastRecentlyUsedSlot(ngs_t *ngs)
+/* Unused slots come first */
+{
+  register long k, slot = 0;
+  for (k = 0; k < ngs->cacheSize; k++)
+  {
+    if (ngs->cachedIndex[k] == NONE) return k;
+    if (ngs->cachedUse[k] < ngs->cachedUse[slot]) slot = k;
+  }
+  return slot;
+}
+
+/****
+ * NULL on error
+ * Replaces any slice of the same dimension that is kept in memory.
+ ***************************************************************************/
+static sS_t *newStoredSlice(ngs_t *ngs, long dim, long rows)
+{
+  sS_t *ss = storedSlice(ngs, dim);
+  if (ss) freeStoredSlice(ngs, ss);
+  ss = (sS_t *) malloc(sizeof(sS_t));
+  if (!ss)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return NULL;
+  }
+  ss->dim = dim;
+  ss->rows = rows;
+  ss->data = NULL;
+  if (rows)
+  {
+    ss->data = FfAlloc(rows);
+    if (!ss->data)
+    { free(ss);
+      MTX_ERROR1("%E", MTX_ERR_NOMEM);
+      return NULL;
+    }
+  }
+  ss->next = ngs->slices;
+  ngs->slices = ss;
+  ngs->sliceBytes += rows * ngs->fc.rowSize;
+  return ss;
+}
+
 /******************************************************************************
  * Return 1 on error
  */
 static int removeStoredProductFile(ngs_t *ngs, long d)
 {
+  sS_t *ss = storedSlice(ngs, d);
+  if (ss)
+  {
+    freeStoredSlice(ngs, ss);
+    return 0;
+  }
   if (remove(storedProductFile(ngs, d)))
   { MTX_ERROR1("Cannot remove file %s", storedProductFile(ngs, d));
     return 1;
@@ -279,10 +485,12 @@ int destroyCurrentDimension(ngs_t *ngs)
   { MTX_ERROR("no current dimension");
     return 1;
   }
+  unmapCurrentDimension(ngs);
   if (ngs->dimLoaded != ngs->expDim)
     { if (removeStoredProductFile(ngs, ngs->dimLoaded)) return 1; }
-  ngs->blockLoaded = NONE;
+  invalidateBlockCache(ngs);
   ngs->dimLoaded = NONE;
+  ngs->sliceLoaded = NULL;
   return 0;
 }
 
@@ -309,37 +517,70 @@ static long smallestDimensionOfReduced(ngs_t *ngs)
 }
 
 /*****
- * 1 on error
+ * NULL on error
  **************************************************************************/
-static int loadBlock(ngs_t *ngs, long block)
+static PTR loadBlock(ngs_t *ngs, long block)
+/* Returns the data of the given block of the current dimension, which is
+ * either found in the block cache or replaces the least recently used block.
+ * The .stp file of the current dimension is mapped on first use.
+ * Since the rows in the file are not aligned, they are copied to the cache.
+ * A compressed .stp file has one compressed block per block of products. */
 {
-  FILE *fp;
   long nor = ngs->r + ngs->s;
-  long totrows, blen = ngs->blockSize;
+  long blen = ngs->blockSize;
   long lastblock = (ngs->nops - 1) / ngs->blockSize;
-  if (block == lastblock)
-    blen = 1 + (ngs->nops-1) % ngs->blockSize;
-  fp = readhdrplus(storedProductFile(ngs, ngs->dimLoaded), NULL, &totrows,
-    NULL);
-  if (!fp) {printf("readhdrplus returns NULL\n"); return 1;}
-  if (totrows != nor * ngs->nops)
+  register long blennor, slot;
+  PTR data;
+  for (slot = 0; slot < ngs->cacheSize; slot++)
+    if (ngs->cachedIndex[slot] == block) break;
+  if (slot < ngs->cacheSize)
   {
-    MTX_ERROR1("incorrect number of rows: %E", MTX_ERR_INCOMPAT);
-    return 1;
+    ngs->cacheHits++;
+    data = ngs->cachedBlock[slot];
   }
-  /*FfSeekRow(fp, 1 + block * nor * ngs->blockSize);*/
-  totrows = FfCurrentRowSizeIo*(block * nor * ngs->blockSize);
-  if (totrows) SysFseekRelative(fp, totrows);
-  register long blennor = blen * nor;
-  totrows = FfReadRows(fp, ngs->thisBlock, blennor);
-  if (totrows != blennor)
-  { fclose(fp);
-    MTX_ERROR2("%s: %E", storedProductFile(ngs, ngs->dimLoaded), MTX_ERR_FILEFMT);
-    return 1;
+  else
+  {
+    ngs->cacheMisses++;
+    if (block == lastblock)
+      blen = 1 + (ngs->nops-1) % ngs->blockSize;
+    if (!ngs->sliceMap)
+    {
+      ngs->sliceMap = mapfileplus(storedProductFile(ngs, ngs->dimLoaded));
+      if (!ngs->sliceMap) return NULL;
+      if (ngs->sliceMap->nor != nor * ngs->nops)
+      {
+        unmapCurrentDimension(ngs);
+        MTX_ERROR1("incorrect number of rows: %E", MTX_ERR_INCOMPAT);
+        return NULL;
+      }
+    }
+    slot = leastRecentlyUsedSlot(ngs);
+    if (!ngs->cachedBlock[slot])
+    {
+      ngs->cachedBlock[slot] = FfAlloc(ngs->blockSize * nor);
+      if (!ngs->cachedBlock[slot])
+      { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+        return NULL;
+      }
+    }
+    data = ngs->cachedBlock[slot];
+    ngs->cachedIndex[slot] = NONE;
+    blennor = blen * nor;
+    double t0 = STATS_CLOCK(ngs);
+    if (mappedReadRows(ngs->sliceMap, block * nor * ngs->blockSize, blennor, data))
+    {
+      MTX_ERROR2("%s: %E", storedProductFile(ngs, ngs->dimLoaded), MTX_ERR_FILEFMT);
+      return NULL;
+    }
+    ngs->cachedIndex[slot] = block;
+    ngs->stats.blockReads++;
+    ngs->stats.blockBytes += blennor * FfCurrentRowSizeIo;
+    STATS_ADD_TIME(ngs, readTime, t0);
   }
-  fclose(fp);
+  ngs->cachedUse[slot] = ++ngs->cacheClock;
   ngs->blockLoaded = block;
-  return 0;
+  ngs->blockData = data;
+  return data;
 }
 
 /*****
@@ -348,7 +589,7 @@ static int loadBlock(ngs_t *ngs, long block)
 PTR nodeVector(ngs_t *ngs, group_t *group, modW_t *node)
 {
   PTR w;
-  long i = node->status;
+  long i = wordState(ngs, node)->status;
   if (i == NO_DIVISOR)
   {
       MTX_ERROR("no divisor");
@@ -361,27 +602,157 @@ PTR nodeVector(ngs_t *ngs, group_t *group, modW_t *node)
     long block = i / ngs->blockSize;
     long pos = i % ngs->blockSize;
     long nor = ngs->r + ngs->s;
-    if (ngs->blockLoaded != block)
-    { if (loadBlock(ngs, block)) return NULL;
+    if (ngs->sliceLoaded)
+      w = rowPtr(&ngs->fc, ngs->sliceLoaded->data, i * nor);
+    else
+    {
+      if (ngs->blockLoaded != block)
+      { if (!loadBlock(ngs, block)) return NULL;
+      }
+      w = rowPtr(&ngs->fc, ngs->blockData, pos * nor);
     }
-    w = FfGetPtr(ngs->thisBlock, pos * nor);
   }
   return w;
 }
 
 static inline void commenceNewDimension(ngs_t *ngs, group_t *group, int dim)
 {
+    unmapCurrentDimension(ngs);
     (ngs)->dimLoaded = dim;
     updateWordStatusData((ngs),(group)), (group);
-    (ngs)->blockLoaded = NONE;
+    invalidateBlockCache(ngs);
+    (ngs)->sliceLoaded = storedSlice(ngs, dim);
 }
 
 
+/* A product w * action[a], to be stored at dest */
+typedef struct
+{
+  PTR w;
+  Matrix_t *mat;
+  PTR dest;
+} product_t;
+
+/* The share of a batch of products that is done by one thread */
+typedef struct
+{
+  product_t *prods;
+  long first, last;
+  long nor;
+  size_t rowSize;
+} productShare_t;
+
+/******************************************************************************/
+static void *productWorker(void *arg)
+/* The field must have been selected by the master thread.
+ * Only FfMapRow is used here, since it does not alter the global state
+ * of MeatAxe (in contrast to the Strassen multiplication). */
+{
+  productShare_t *share = (productShare_t *) arg;
+  register long i, j;
+  register PTR p1, p2;
+  for (i = share->first; i < share->last; i++)
+  {
+    product_t *prod = share->prods + i;
+    for (j = 0, p1 = prod->w, p2 = prod->dest; j < share->nor;
+         j++, p1+=share->rowSize, p2+=share->rowSize)
+      FfMapRow(p1, prod->mat->Data, prod->mat->Nor, p2);
+  }
+  return NULL;
+}
+
+/*****
+ * 1 on error
+ **************************************************************************/
+static int computeProducts(ngs_t *ngs, product_t *prods, long n)
+/* Distributes the n products over ngs->threads threads.
+ * If a thread can not be started, its share is done by the master thread. */
+{
+  productShare_t share[MAX_WORKER_THREADS];
+  pthread_t tid[MAX_WORKER_THREADS];
+  boolean started[MAX_WORKER_THREADS];
+  register long t;
+  long nor = ngs->r + ngs->s;
+  long threads = ngs->threads;
+  long chunk;
+  if (n == 0) return 0;
+  if (threads > n) threads = n;
+  if (threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+  if (threads <= 1)
+  {
+    for (t = 0; t < n; t++)
+      if (multiply(prods[t].w, prods[t].mat, prods[t].dest, nor)) return 1;
+    return 0;
+  }
+  selectField(prods[0].mat->Field, prods[0].mat->Noc);
+  chunk = (n + threads - 1) / threads;
+  for (t = 0; t < threads; t++)
+  {
+    share[t].prods = prods;
+    share[t].nor = nor;
+    share[t].rowSize = ngs->fc.rowSize;
+    share[t].first = (t * chunk < n) ? t * chunk : n;
+    share[t].last = ((t+1) * chunk < n) ? (t+1) * chunk : n;
+    started[t] = false;
+  }
+  for (t = 1; t < threads; t++)
+    started[t] = !pthread_create(tid + t, NULL, productWorker, share + t);
+  productWorker(share);
+  for (t = 1; t < threads; t++)
+  {
+    if (started[t]) pthread_join(tid[t], NULL);
+    else productWorker(share + t);
+  }
+  return 0;
+}
+
+/*****
+ * 1 on error
+ **************************************************************************/
+static int writeProducts(FILE *fp, ngs_t *ngs, long offset)
+{
+  long nor = ngs->r + ngs->s;
+  if (FfWriteRows(fp, ngs->theseProds, nor * offset) != nor * offset)
+  { MTX_ERROR1("expected nor * offset: %E", MTX_ERR_INCOMPAT);
+    return 1;
+  }
+  return 0;
+}
+
+/******************************************************************************/
+static long numberOfNextProducts(ngs_t *ngs, group_t *group)
+{
+  long d = ngs->dimLoaded;
+  register long a, pat, blo;
+  register long n = 0;
+  long arrows = group->arrows;
+  register const int32_t *kids;
+  register wordState_t *ws;
+  for (blo = 0; blo < ngs->r; blo++)
+  {
+    ws = ngs->wstate + blo * group->nontips;
+    for (pat = group->dS[d]; pat < group->dS[d+1]; pat++)
+    {
+      if (ws[pat].status == NO_DIVISOR) continue;
+      kids = group->pathChild + pat * arrows;
+      for (a = 0; a < arrows; a++)
+        if (kids[a] >= 0) n++;
+    }
+  }
+  return n;
+}
+
 /*****
  * 1 on error
  **************************************************************************/
 static int calculateNextProducts(ngs_t *ngs, group_t *group)
-/* Assumes ngs->dimLoaded is set */
+/* Assumes ngs->dimLoaded is set.
+ * If the memory budget of ngs suffices, the products are kept in memory;
+ * otherwise they are written to a .stp file.
+ * The products are collected in batches of at most ngs->blockSize, which are
+ * computed by computeProducts and then written in the order of the batch.
+ * Since the factors w may be taken from the block cache, a batch is computed
+ * before a different block is loaded. */
 {
   long d = ngs->dimLoaded;
   /* long lS = layerSize(ngs, group, d); */
@@ -391,46 +762,84 @@ static int calculateNextProducts(ngs_t *ngs, group_t *group)
   long nor = ngs->r + ngs->s;
   register long nops = 0;
   register long offset = 0;
-  modW_t *node;
-  PTR w, dest;
-  FILE *fp = writehdrplus(storedProductFile(ngs, d+1), FfOrder, 0, group->nontips);
-  if (!fp) return 1;
+  long pending = 0;
+  long status;
+  const int32_t *kids;
+  wordState_t *ws;
+  PTR w;
+  FILE *fp = NULL;
+  sS_t *ss = NULL;
+  long total = numberOfNextProducts(ngs, group);
+  double t0 = STATS_CLOCK(ngs);
+  product_t *prods = (product_t *) malloc(ngs->blockSize * sizeof(product_t));
+  if (!prods)
+  { MTX_ERROR1("%E", MTX_ERR_NOMEM);
+    return 1;
+  }
+  if (sliceFitsInMemory(ngs, total * nor))
+  {
+    ss = newStoredSlice(ngs, d+1, total * nor);
+    if (!ss) { free(prods); return 1; }
+  }
+  else
+  {
+    fp = writehdrplus(storedProductFile(ngs, d+1), FfOrder, 0, group->nontips);
+    if (!fp) { free(prods); return 1; }
+  }
   for (blo = 0; blo < ngs->r; blo++)
+  {
+    ws = ngs->wstate + blo * group->nontips;
     for (pat = group->dS[d]; pat < group->dS[d+1]; pat++)
     {
-      node = ngs->proot[blo] + pat;
-      if (node->status == NO_DIVISOR) continue;
-      w = nodeVector(ngs, group, node);
-      if (!w) return 1;
+      status = ws[pat].status;
+      if (status == NO_DIVISOR) continue;
+      if (pending && !ngs->sliceLoaded && status >= 0 &&
+          status / ngs->blockSize != ngs->blockLoaded)
+      {
+        if (computeProducts(ngs, prods, pending))
+        { free(prods); if (fp) fclose(fp); return 1; }
+        pending = 0;
+      }
+      w = nodeVector(ngs, group, ngs->proot[blo] + pat);
+      if (!w) { free(prods); if (fp) fclose(fp); return 1; }
+      kids = group->pathChild + pat * group->arrows;
       for (a = 0; a < group->arrows; a++)
       {
-        if (node->child[a])
+        if (kids[a] >= 0)
         {
-          dest = FfGetPtr(ngs->theseProds, nor * offset++);
-          if (multiply(w, group->action[a], dest, nor)) return 1;
+          prods[pending].w = w;
+          prods[pending].mat = group->action[a];
+          prods[pending].dest = (ss) ? rowPtr(&ngs->fc, ss->data, nor * nops) :
+            rowPtr(&ngs->fc, ngs->theseProds, nor * offset);
+          pending++;
+          offset++;
           nops++;
           if (offset == ngs->blockSize)
           {
-            if (FfWriteRows(fp, ngs->theseProds, nor * offset) != nor * offset)
-            { fclose(fp);
-              MTX_ERROR1("expected nor * offset: %E", MTX_ERR_INCOMPAT);
-              return 1;
-            }
+            if (computeProducts(ngs, prods, pending) ||
+                (fp && writeProducts(fp, ngs, offset)))
+            { free(prods); if (fp) fclose(fp); return 1; }
+            pending = 0;
             offset = 0;
           }
         }
       }
     }
+  }
   if (offset != 0)
   {
-    if (FfWriteRows(fp, ngs->theseProds, nor * offset) != nor * offset)
-    { fclose(fp);
-      MTX_ERROR1("expected nor * offset: %E", MTX_ERR_INCOMPAT);
-      return 1;
-    }
+    if (computeProducts(ngs, prods, pending) ||
+        (fp && writeProducts(fp, ngs, offset)))
+    { free(prods); if (fp) fclose(fp); return 1; }
   }
+  free(prods);
+  ngs->stats.products += nops;
+  STATS_ADD_TIME(ngs, productTime, t0);
+  if (!fp) return 0;
   int r = alterhdrplus(fp, nops * nor);
   fclose(fp);
+  if (!r && ngs->compressSlices)
+    r = compressMatrixFile(storedProductFile(ngs, d+1), nor * ngs->blockSize);
   return r;
 }
 
@@ -439,6 +848,8 @@ static int calculateNextProducts(ngs_t *ngs, group_t *group)
  ***************************************************************************/
 static int createEmptySliceFile(ngs_t *ngs, group_t *group, long d)
 {
+  if (sliceFitsInMemory(ngs, 0))
+    return (newStoredSlice(ngs, d, 0)) ? 0 : 1;
   FILE *fp = writehdrplus(storedProductFile(ngs, d), FfOrder, 0, group->nontips);
   if (!fp) return 1;
   fclose(fp);
@@ -523,3 +934,20 @@ int selectNewDimension(ngs_t *ngs, group_t *group, long dim)
     if (incrementSlice(ngs, group)) return 1;
   return 0;
 }
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int rebuildExpansionSlice(ngs_t *ngs, group_t *group)
+/* After the vectors have been restored from a checkpoint, the slice of
+ * products in the expansion dimension is computed from the reduced vectors */
+{
+  long dim = ngs->expDim;
+  if (!expansionSlicePresent(ngs)) return 0;
+  if (destroyCurrentDimensionIfAny(ngs)) return 1;
+  ngs->expDim = NOTHING_TO_EXPAND; /* lower slices are not kept */
+  int r = selectNewDimension(ngs, group, dim);
+  ngs->expDim = dim;
+  if (r) return 1;
+  return destroyCurrentDimension(ngs); /* keeps the slice of dimension dim */
+}
@@ -26,7 +26,9 @@
 #define __SLICE_DECLS_INCLUDED
 
 PTR nodeVector(ngs_t *ngs, group_t *group, modW_t *node);
-void freeGeneralVector(gV_t *gv);
+void freeGeneralVector(ngs_t *ngs, gV_t *gv);
+int growVectorPool(ngs_t *ngs);
+void freeVectorPool(ngs_t *ngs);
 // gV_t *popGeneralVector(ngs_t *ngs);
 void pushGeneralVector(ngs_t *ngs, gV_t *gv);
 int makeVectorMonic(ngs_t *ngs, gV_t *gv);
@@ -36,9 +38,13 @@ int createWordForest(ngs_t *ngs, group_t *group);
 int destroyCurrentDimension(ngs_t *ngs);
 int destroyCurrentDimensionIfAny(ngs_t *ngs);
 int destroyExpansionSliceFile(ngs_t *ngs);
+void freeStoredSlices(ngs_t *ngs);
+int setBlockCacheSize(ngs_t *ngs, long size);
+void freeBlockCache(ngs_t *ngs);
 int selectNewDimension(ngs_t *ngs, group_t *group, long dim);
 int loadExpansionSlice(ngs_t *ngs, group_t *group);
 int incrementSlice(ngs_t *ngs, group_t *group);
+int rebuildExpansionSlice(ngs_t *ngs, group_t *group);
 
 void findLeadingMonomial(gV_t *gV, long r, group_t *group);
 
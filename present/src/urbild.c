@@ -25,6 +25,7 @@
 #include "nDiag.h"
 #include "slice_decls.h"
 #include "fp_decls.h"
+#include "aufnahme.h"
 #include "meataxe.h"
 
 MTX_DEFINE_FILE_INFO
@@ -92,8 +93,8 @@ Matrix_t *getMinimalGenerators(nFgs_t *nFgs, group_t *group)
     {
       b = (char *)gv->w;
       for (i = 0; i < ngs->r; ++i)
-    { memcpy(p,b,FfCurrentRowSize);
-      b += FfCurrentRowSize;
+    { memcpy(p,b,ngs->fc.rowSize);
+      b += ngs->fc.rowSize;
       FfStepPtr(&(p));
     }
     }
@@ -227,7 +228,7 @@ int saveNRgs(nRgs_t *nRgs, group_t *group, char *outfile, char *markfile)
   fp = writehdrplus(markfile, FfOrder, 0, group->nontips);
   if (!fp) return 1;
   for (rv = ngs->firstReduced, nor = 0; rv ; rv = rv->next, nor += ngs->s)
-    if (FfWriteRows(fp, FfGetPtr(rv->gv->w, ngs->r), ngs->s) != ngs->s)
+    if (FfWriteRows(fp, rowPtr(&ngs->fc, rv->gv->w, ngs->r), ngs->s) != ngs->s)
     {
         fclose(fp);
         return 1;
@@ -238,6 +239,8 @@ int saveNRgs(nRgs_t *nRgs, group_t *group, char *outfile, char *markfile)
   return r;
 }
 
+void freeNgs(ngs_t *ngs);
+
 /****
  * Null on error
  ***************************************************************/
@@ -248,15 +251,25 @@ static ngs_t *ngsAllocation(long r, long s, group_t *group, char *stem)
   { MTX_ERROR1("%E", MTX_ERR_NOMEM);
     return NULL;
   }
+  if (group->fc.fl != group->p || group->fc.noc != group->nontips)
+    setFieldContext(&group->fc, group->p, group->nontips);
+  ngs->fc = group->fc;
+  selectBlockKernels(ngs);
   ngs->r = r;
   ngs->s = s;
   ngs->firstReduced = NULL;
   ngs->lastReduced = NULL;
   ngs->unreducedHeap = NULL;
+  memset(ngs->reducedSkip, 0, SKIP_LEVELS * sizeof(rV_t *));
+  memset(ngs->unreducedSkip, 0, SKIP_LEVELS * sizeof(uV_t *));
+  ngs->skipSeed = 88172645463325252UL;
   ngs->pnontips = r * group->nontips;
   ngs->expDim = NOTHING_TO_EXPAND;
   ngs->targetRank = RANK_UNKNOWN;
-  ngs->gVwaiting = NULL;
+  ngs->slabs = NULL;
+  ngs->freeGV = NULL;
+  ngs->freeUV = NULL;
+  ngs->freeRV = NULL;
   if (createWordForest(ngs, group))
   { free(ngs);
     return NULL;
@@ -264,14 +277,33 @@ static ngs_t *ngsAllocation(long r, long s, group_t *group, char *stem)
   ngs->dimLoaded = NONE;
   ngs->blockLoaded = NONE;
   ngs->blockSize = BLOCK_SIZE;
+  ngs->threads = WORKER_THREADS;
+  ngs->slices = NULL;
+  ngs->sliceLoaded = NULL;
+  ngs->sliceMap = NULL;
+  ngs->cachedBlock = NULL;
+  ngs->cachedIndex = NULL;
+  ngs->cachedUse = NULL;
+  ngs->cacheSize = 0;
+  ngs->cacheHits = 0;
+  ngs->cacheMisses = 0;
+  memset(&ngs->stats, 0, sizeof(bStat_t));
+  ngs->sliceMemory = SLICE_MEMORY;
+  ngs->sliceBytes = 0;
+  ngs->compressSlices = false;
+  ngs->timing = false;
   ngs->thisBlock = FfAlloc(ngs->blockSize * (r + s));
   ngs->theseProds = FfAlloc(ngs->blockSize * (r + s));
   ngs->w = FfAlloc(r + s);
   if (!ngs->thisBlock || !ngs->theseProds || !ngs->w)
-  { free(ngs);
+  { freeNgs(ngs);
     MTX_ERROR1("%E", MTX_ERR_NOMEM);
     return NULL;
   }
+  if (setBlockCacheSize(ngs, BLOCK_CACHE))
+  { freeNgs(ngs);
+    return NULL;
+  }
   strcpy(ngs->stem, stem);
   return ngs;
 }
@@ -302,61 +334,38 @@ nFgs_t *nFgsAllocation(group_t *group, long r, char *stem)
 
 /******************************************************************************/
 void freeReducedVector(rV_t *rv, ngs_t *ngs)
+/* Returns rv and its general vector to the vector pool of ngs */
 {
-  if (rv->gv) freeGeneralVector(rv->gv);
-  free(rv);
-  return;
-}
-
-/******************************************************************************/
-static void freeReducedVectors(rV_t *first, ngs_t *ngs)
-{
-  rV_t *rv, *next;
-  if (first && first->prev) first->prev->next = NULL;
-  for (rv = first; rv; rv = next)
-  {
-    next = rv->next;
-    freeReducedVector(rv, ngs);
-  }
+  if (rv->gv) freeGeneralVector(ngs, rv->gv);
+  rv->next = ngs->freeRV;
+  ngs->freeRV = rv;
   return;
 }
 
 /******************************************************************************/
-void freeUnreducedVector(uV_t *uv)
+void freeUnreducedVector(ngs_t *ngs, uV_t *uv)
+/* Returns uv and its general vector to the vector pool of ngs */
 {
-  if (uv->gv) freeGeneralVector(uv->gv);
-  free(uv);
-  return;
-}
-
-/******************************************************************************/
-static void freeUnreducedVectors(ngs_t *ngs)
-{
-  uV_t *first = ngs->unreducedHeap;
-  uV_t *uv, *next;
-  if (first && first->prev) first->prev->next = NULL;
-  for (uv = first; uv; uv = next)
-  {
-    next = uv->next;
-    freeUnreducedVector(uv);
-  }
+  if (uv->gv) freeGeneralVector(ngs, uv->gv);
+  uv->next = ngs->freeUV;
+  ngs->freeUV = uv;
   return;
 }
 
 /******************************************************************************/
 void freeNgs(ngs_t *ngs)
 {
-  freeReducedVectors(ngs->firstReduced, ngs);
-  freeUnreducedVectors(ngs);
+  freeVectorPool(ngs);
   if (ngs->proot)
   {
     // freeWordForest(ngs);
     modW_t **proot = ngs->proot;
-    free(proot[0][0].child);
+    free(ngs->wstate);
     free(proot[0]);
     free(proot);
   }
-  if (ngs->gVwaiting) freeGeneralVector(ngs->gVwaiting);
+  freeStoredSlices(ngs);
+  freeBlockCache(ngs);
   if (ngs->thisBlock) free(ngs->thisBlock);
   if (ngs->theseProds) free(ngs->theseProds);
   if (ngs->w) free(ngs->w);
@@ -389,9 +398,75 @@ nRgs_t *nRgsAllocation(group_t *group, long r, long s, char *stem)
     return NULL;
   }
   nRgs->overshoot = MAX_OVERSHOOT;
+  nRgs->resumed = false;
+  nRgs->checkpointInterval = 0;
+  nRgs->lastCheckpoint = 0;
+  nRgs->checkpoint[0] = '\0';
   return nRgs;
 }
 
+/******************************************************************************/
+void nRgsSetThreads(nRgs_t *nRgs, long threads)
+/* Number of threads for the products of both nRgs and its kernel */
+{
+  if (threads < 1) threads = 1;
+  if (threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+  nRgs->ngs->threads = threads;
+  nRgs->ker->ngs->threads = threads;
+  return;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+int nRgsSetBlockCache(nRgs_t *nRgs, long blocks)
+/* Number of cached blocks for both nRgs and its kernel */
+{
+  if (setBlockCacheSize(nRgs->ngs, blocks)) return 1;
+  return setBlockCacheSize(nRgs->ker->ngs, blocks);
+}
+
+/******************************************************************************/
+void nRgsSetCheckpoint(nRgs_t *nRgs, char *file, double seconds)
+/* nRgsBuchberger saves its state to file whenever the given number of
+ * seconds has passed since the previous checkpoint; never if seconds <= 0 */
+{
+  nRgs->checkpointInterval = (seconds > 0) ? seconds : 0;
+  nRgs->lastCheckpoint = statisticsClock();
+  strncpy(nRgs->checkpoint, file, MAXLINE-1);
+  nRgs->checkpoint[MAXLINE-1] = '\0';
+  return;
+}
+
+/******************************************************************************/
+void nRgsSetSliceMemory(nRgs_t *nRgs, long bytes)
+/* Memory budget for the slices of both nRgs and its kernel.
+ * A negative budget is treated as zero, i.e., no slice is kept in memory */
+{
+  if (bytes < 0) bytes = 0;
+  nRgs->ngs->sliceMemory = (size_t) bytes;
+  nRgs->ker->ngs->sliceMemory = (size_t) bytes;
+  return;
+}
+
+/******************************************************************************/
+void nRgsSetCompression(nRgs_t *nRgs, boolean compress)
+/* Whether the .stp files of both nRgs and its kernel are compressed */
+{
+  nRgs->ngs->compressSlices = compress;
+  nRgs->ker->ngs->compressSlices = compress;
+  return;
+}
+
+/******************************************************************************/
+void nRgsSetTiming(nRgs_t *nRgs, boolean timing)
+/* Whether the statistics of both nRgs and its kernel contain timings */
+{
+  nRgs->ngs->timing = timing;
+  nRgs->ker->ngs->timing = timing;
+  return;
+}
+
 /******************************************************************************/
 void freeNFgs(nFgs_t *nFgs)
 {
@@ -422,12 +497,31 @@ static boolean vectorLessThan(gV_t *w1, gV_t *w2)
   return false;
 }
 
+/******************************************************************************/
+static int skipListLevel(ngs_t *ngs)
+/* Level of a new skip list entry: level l+1 with probability 4^-l */
+{
+  register unsigned long x = ngs->skipSeed;
+  int level = 1;
+  x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+  ngs->skipSeed = x;
+  for (x >>= 32; level < SKIP_LEVELS && !(x & 3); x >>= 2) level++;
+  return level;
+}
+
 /******************************************************************************/
 static rV_t *reducedSuccessor(ngs_t *ngs, rV_t *rv)
 {
   return (rv == NULL) ? ngs->firstReduced : rv->next;
 }
 
+/******************************************************************************/
+static rV_t *reducedSkipSuccessor(ngs_t *ngs, rV_t *rv, int l)
+{
+  if (l == 0) return reducedSuccessor(ngs, rv);
+  return (rv == NULL) ? ngs->reducedSkip[l] : rv->skipNext[l];
+}
+
 /******************************************************************************/
 static void insertReducedVectorAfter(ngs_t *ngs, rV_t *base, rV_t *rv)
 {
@@ -473,11 +567,30 @@ static int lowerExpDimIfNecessary(ngs_t *ngs, long d)
  **************************************************************************/
 int insertReducedVector(ngs_t *ngs, rV_t *rv)
 /* See expansion routines for info on expDim */
+/* rv goes after all vectors that are not less than rv */
 {
-  rV_t *base = ngs->lastReduced;
-  while (base && vectorLessThan(base->gv, rv->gv))
-    base = base->prev;
+  rV_t *update[SKIP_LEVELS];
+  register rV_t *base = NULL;
+  register rV_t *succ;
+  register int l;
+  for (l = SKIP_LEVELS - 1; l >= 0; l--)
+  {
+    while ((succ = reducedSkipSuccessor(ngs, base, l)) &&
+      !vectorLessThan(succ->gv, rv->gv))
+      base = succ;
+    update[l] = base;
+  }
   insertReducedVectorAfter(ngs, base, rv);
+  rv->level = skipListLevel(ngs);
+  for (l = 1; l < rv->level; l++)
+  {
+    succ = reducedSkipSuccessor(ngs, update[l], l);
+    rv->skipPrev[l] = update[l];
+    rv->skipNext[l] = succ;
+    if (succ) succ->skipPrev[l] = rv;
+    if (update[l]) update[l]->skipNext[l] = rv;
+    else ngs->reducedSkip[l] = rv;
+  }
   rv->expDim = rv->gv->dim;
   return lowerExpDimIfNecessary(ngs, rv->expDim);
 }
@@ -486,6 +599,7 @@ int insertReducedVector(ngs_t *ngs, rV_t *rv)
 void unlinkReducedVector(ngs_t *ngs, rV_t *rv)
 {
   rV_t *rv1;
+  int l;
   rv1 = rv->prev;
   if (rv1 == NULL)
     ngs->firstReduced = rv->next;
@@ -497,6 +611,18 @@ void unlinkReducedVector(ngs_t *ngs, rV_t *rv)
   else
     rv1->prev = rv->prev;
   rv->prev = NULL; rv->next = NULL;
+  for (l = 1; l < rv->level; l++)
+  {
+    rv1 = rv->skipPrev[l];
+    if (rv1 == NULL)
+      ngs->reducedSkip[l] = rv->skipNext[l];
+    else
+      rv1->skipNext[l] = rv->skipNext[l];
+    rv1 = rv->skipNext[l];
+    if (rv1 != NULL)
+      rv1->skipPrev[l] = rv->skipPrev[l];
+  }
+  rv->level = 1;
   return;
 }
 
@@ -505,13 +631,12 @@ void unlinkReducedVector(ngs_t *ngs, rV_t *rv)
  **************************************************************************/
 uV_t *unreducedVector(ngs_t *ngs, gV_t *gv)
 {
-  uV_t *uv = (uV_t *) malloc(sizeof(uV_t));
-  if (!uv)
-      {
-          MTX_ERROR1("%E", MTX_ERR_NOMEM);
-          return NULL;
-      }
+  uV_t *uv;
+  if (!ngs->freeUV && growVectorPool(ngs)) return NULL;
+  uv = ngs->freeUV;
+  ngs->freeUV = uv->next;
   uv->gv = gv; uv->prev = NULL; uv->next = NULL;
+  uv->level = 1;
   return uv;
 }
 
@@ -521,6 +646,13 @@ uV_t *unreducedSuccessor(ngs_t *ngs, uV_t *uv)
   return (uv == NULL) ? ngs->unreducedHeap : uv->next;
 }
 
+/******************************************************************************/
+static uV_t *unreducedSkipSuccessor(ngs_t *ngs, uV_t *uv, int l)
+{
+  if (l == 0) return unreducedSuccessor(ngs, uv);
+  return (uv == NULL) ? ngs->unreducedSkip[l] : uv->skipNext[l];
+}
+
 /******************************************************************************/
 static void insertUnreducedVectorAfter(ngs_t *ngs, uV_t *base, uV_t *uv)
 {
@@ -538,13 +670,30 @@ static void insertUnreducedVectorAfter(ngs_t *ngs, uV_t *base, uV_t *uv)
 
 /******************************************************************************/
 void insertUnreducedVector(ngs_t *ngs, uV_t *uv)
+/* uv goes after all vectors that are greater than uv */
 {
+  uV_t *update[SKIP_LEVELS];
   register uV_t *base = NULL;
   register uV_t *succ;
-  while ((succ = unreducedSuccessor(ngs,base)) &&
-    vectorLessThan(uv->gv, succ->gv))
-    base = succ;
+  register int l;
+  for (l = SKIP_LEVELS - 1; l >= 0; l--)
+  {
+    while ((succ = unreducedSkipSuccessor(ngs, base, l)) &&
+      vectorLessThan(uv->gv, succ->gv))
+      base = succ;
+    update[l] = base;
+  }
   insertUnreducedVectorAfter(ngs, base, uv);
+  uv->level = skipListLevel(ngs);
+  for (l = 1; l < uv->level; l++)
+  {
+    succ = unreducedSkipSuccessor(ngs, update[l], l);
+    uv->skipPrev[l] = update[l];
+    uv->skipNext[l] = succ;
+    if (succ) succ->skipPrev[l] = uv;
+    if (update[l]) update[l]->skipNext[l] = uv;
+    else ngs->unreducedSkip[l] = uv;
+  }
   return;
 }
 
@@ -563,6 +712,7 @@ int insertNewUnreducedVector(ngs_t *ngs, gV_t *gv)
 void unlinkUnreducedVector(ngs_t *ngs, uV_t *uv)
 {
   uV_t *uv1;
+  int l;
   uv1 = uv->prev;
   if (uv1 == NULL)
     ngs->unreducedHeap = uv->next;
@@ -572,22 +722,33 @@ void unlinkUnreducedVector(ngs_t *ngs, uV_t *uv)
   if (uv1 != NULL)
     uv1->prev = uv->prev;
   uv->prev = NULL; uv->next = NULL;
+  for (l = 1; l < uv->level; l++)
+  {
+    uv1 = uv->skipPrev[l];
+    if (uv1 == NULL)
+      ngs->unreducedSkip[l] = uv->skipNext[l];
+    else
+      uv1->skipNext[l] = uv->skipNext[l];
+    uv1 = uv->skipNext[l];
+    if (uv1 != NULL)
+      uv1->skipPrev[l] = uv->skipPrev[l];
+  }
+  uv->level = 1;
   return;
 }
 
 /*****
  * NULL on error
  **************************************************************************/
-rV_t *reducedVector(gV_t *gv, group_t *group)
+rV_t *reducedVector(ngs_t *ngs, gV_t *gv, group_t *group)
 {
-  rV_t *rv = (rV_t *) malloc(sizeof(rV_t));
-  if (!rv)
-      {
-          MTX_ERROR1("%E", MTX_ERR_NOMEM);
-          return NULL;
-      }
+  rV_t *rv;
+  if (!ngs->freeRV && growVectorPool(ngs)) return NULL;
+  rv = ngs->freeRV;
+  ngs->freeRV = rv->next;
   rv->gv = gv;
   rv->node = NULL; rv->next = NULL; rv->prev = NULL;
+  rv->level = 1;
   return rv;
 }
 
@@ -606,7 +767,7 @@ int processNewFlaggedGenerator(nFgs_t *nFgs, PTR w, group_t *group)
   gv->w = w_tmp;
   if (gv->dim != ZERO_BLOCK)
   {
-    memcpy(gv->w, w, (FfCurrentRowSize*ngs->r));
+    memcpy(gv->w, w, (ngs->fc.rowSize*ngs->r));
     gv->radical = false;
     /* false means: not known to be in radical of kernel */
     if (makeVectorMonic(ngs, gv)) return 1;
@@ -624,7 +785,7 @@ int nFgsInitializeVectors(nFgs_t *nFgs, PTR mat, long n, group_t *group)
   ngs_t *ngs = nFgs->ngs;
   PTR w;
   register long i;
-  for (w = mat, i = 0; i < n; i++, w = FfGetPtr(w, ngs->r))
+  for (w = mat, i = 0; i < n; i++, w = rowPtr(&ngs->fc, w, ngs->r))
     if (processNewFlaggedGenerator(nFgs, w, group)) return 1;
   return 0;
 }
@@ -640,7 +801,7 @@ int nRgsInitializeVectors(nRgs_t *nRgs, PTR im, PTR pre, long n,
   gV_t *gv;
   register long i;
   for (w = im, m = pre, i = 0; i < n;
-    i++, w = FfGetPtr(w, ngs->r), m = FfGetPtr(m, ngs->s))
+    i++, w = rowPtr(&ngs->fc, w, ngs->r), m = rowPtr(&ngs->fc, m, ngs->s))
   {
     gv = popGeneralVector(ngs);
     if (!gv)
@@ -659,11 +820,208 @@ int nRgsInitializeVectors(nRgs_t *nRgs, PTR im, PTR pre, long n,
     }
     else
     {
-      memcpy(gv->w, w, (FfCurrentRowSize*ngs->r));
-      memcpy(FfGetPtr(gv->w, ngs->r), m, (FfCurrentRowSize*ngs->s));
+      memcpy(gv->w, w, (ngs->fc.rowSize*ngs->r));
+      memcpy(rowPtr(&ngs->fc, gv->w, ngs->r), m, (ngs->fc.rowSize*ngs->s));
       if (makeVectorMonic(ngs, gv)) return MTX_ERROR("Error in makeVectorMonic"),1;
       if (insertNewUnreducedVector(ngs, gv)) return  MTX_ERROR("Error in insertNewUnreducedVector"),1;
     }
   }
   return 0;
 }
+
+/******************************************************************************
+ * Checkpoints of nRgsBuchberger
+ *
+ * A checkpoint is taken between two expansions, when no slice is loaded.
+ * It contains the reduced and unreduced vectors of nRgs->ngs and of
+ * nRgs->ker->ngs, with their flags and expansion dimensions, and the
+ * status data of the Buchberger algorithm. The word forest and the slice
+ * of products in the expansion dimension are not stored: The word forest
+ * is determined by the reduced vectors, and the slice is computed anew by
+ * rebuildExpansionSlice when the Buchberger algorithm is resumed.
+ * The file is written in the native byte order and is not meant to be
+ * moved to a different platform.
+ ******************************************************************************/
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int writeLongs(FILE *fp, long *x, size_t n)
+{
+  if (fwrite(x, sizeof(long), n, fp) != n)
+  { MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  return 0;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int readLongs(FILE *fp, long *x, size_t n)
+{
+  if (fread(x, sizeof(long), n, fp) != n)
+  { MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  return 0;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int writeNgsCheckpoint(FILE *fp, ngs_t *ngs)
+{
+  long nor = ngs->r + ngs->s;
+  long head[6], flags[2];
+  rV_t *rv;
+  uV_t *uv;
+  head[0] = ngs->expDim;
+  head[1] = ngs->pnontips;
+  head[2] = ngs->prev_pnon;
+  head[3] = ngs->unfruitful;
+  head[4] = numberOfReducedVectors(ngs);
+  head[5] = numberOfUnreducedVectors(ngs);
+  if (writeLongs(fp, head, 6)) return 1;
+  if (fwrite(&ngs->stats, sizeof(bStat_t), 1, fp) != 1)
+  { MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  for (rv = ngs->firstReduced; rv; rv = rv->next)
+  {
+    flags[0] = rv->gv->radical;
+    flags[1] = rv->expDim;
+    if (writeLongs(fp, flags, 2)) return 1;
+    if (FfWriteRows(fp, rv->gv->w, nor) != nor) return 1;
+  }
+  for (uv = ngs->unreducedHeap; uv; uv = uv->next)
+  {
+    flags[0] = uv->gv->radical;
+    flags[1] = NONE;
+    if (writeLongs(fp, flags, 2)) return 1;
+    if (FfWriteRows(fp, uv->gv->w, nor) != nor) return 1;
+  }
+  return 0;
+}
+
+/****
+ * 1 on error
+ ***************************************************************************/
+static int readNgsCheckpoint(FILE *fp, ngs_t *ngs, group_t *group)
+/* ngs must be freshly allocated */
+{
+  long nor = ngs->r + ngs->s;
+  long head[6], flags[2];
+  register long i;
+  gV_t *gv;
+  rV_t *rv;
+  if (readLongs(fp, head, 6)) return 1;
+  if (fread(&ngs->stats, sizeof(bStat_t), 1, fp) != 1)
+  { MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+    return 1;
+  }
+  /* Reduced vectors are inserted without touching the slices */
+  ngs->expDim = NO_BUCHBERGER_REQUIRED;
+  for (i = 0; i < head[4] + head[5]; i++)
+  {
+    if (readLongs(fp, flags, 2)) return 1;
+    gv = popGeneralVector(ngs);
+    if (!gv) return 1;
+    if (FfReadRows(fp, gv->w, nor) != nor)
+    { MTX_ERROR1("%E", MTX_ERR_FILEFMT);
+      return 1;
+    }
+    gv->radical = flags[0] ? true : false;
+    findLeadingMonomial(gv, ngs->r, group);
+    if (i < head[4])
+    {
+      rv = ngsAssertReducedVector(ngs, gv, group);
+      if (!rv) return 1;
+      rv->expDim = flags[1];
+    }
+    else if (insertNewUnreducedVector(ngs, gv)) return 1;
+  }
+  if (ngs->pnontips != head[1])
+  { MTX_ERROR3("%d nontips expected, got %d: %E", head[1], ngs->pnontips, MTX_ERR_INCOMPAT);
+    return 1;
+  }
+  ngs->expDim = head[0];
+  ngs->prev_pnon = head[2];
+  ngs->unfruitful = head[3];
+  return 0;
+}
+
+/*****
+ * 1 on error
+ **************************************************************************/
+int saveNRgsCheckpoint(nRgs_t *nRgs, group_t *group, char *outfile)
+/* The checkpoint is written to a temporary file, that replaces outfile
+ * only when complete. Hence, an interruption does not destroy a previous
+ * checkpoint. */
+{
+  char tmpfile[MAXLINE+4];
+  long head[8];
+  FILE *fp;
+  sprintf(tmpfile, "%s.tmp", outfile);
+  fp = fopen(tmpfile, "wb");
+  if (!fp)
+  { MTX_ERROR1("Cannot open %s", tmpfile);
+    return 1;
+  }
+  head[0] = CHECKPOINT_MAGIC;
+  head[1] = FfOrder;
+  head[2] = group->nontips;
+  head[3] = nRgs->ngs->r;
+  head[4] = nRgs->ngs->s;
+  head[5] = nRgs->prev_ker_pnon;
+  head[6] = nRgs->ker->finished;
+  head[7] = nRgs->ker->nRgsUnfinished;
+  if (writeLongs(fp, head, 8) || writeNgsCheckpoint(fp, nRgs->ngs) ||
+      writeNgsCheckpoint(fp, nRgs->ker->ngs))
+  { fclose(fp);
+    remove(tmpfile);
+    return 1;
+  }
+  if (fclose(fp) || rename(tmpfile, outfile))
+  { MTX_ERROR1("Cannot write %s", outfile);
+    return 1;
+  }
+  return 0;
+}
+
+/*****
+ * 1 on error
+ **************************************************************************/
+int restoreNRgsCheckpoint(nRgs_t *nRgs, group_t *group, char *infile)
+/* nRgs must be freshly allocated by nRgsAllocation. Afterwards,
+ * nRgsBuchberger continues with the saved state. */
+{
+  long head[8];
+  FILE *fp = fopen(infile, "rb");
+  if (!fp)
+  { MTX_ERROR1("Cannot open %s", infile);
+    return 1;
+  }
+  if (readLongs(fp, head, 8))
+  { fclose(fp);
+    return 1;
+  }
+  if (head[0] != CHECKPOINT_MAGIC || head[1] != FfOrder ||
+      head[2] != group->nontips || head[3] != nRgs->ngs->r ||
+      head[4] != nRgs->ngs->s)
+  { fclose(fp);
+    MTX_ERROR2("%s: %E", infile, MTX_ERR_FILEFMT);
+    return 1;
+  }
+  if (readNgsCheckpoint(fp, nRgs->ngs, group) ||
+      readNgsCheckpoint(fp, nRgs->ker->ngs, group))
+  { fclose(fp);
+    return 1;
+  }
+  fclose(fp);
+  nRgs->prev_ker_pnon = head[5];
+  nRgs->ker->finished = head[6] ? true : false;
+  nRgs->ker->nRgsUnfinished = head[7] ? true : false;
+  nRgs->resumed = true;
+  return 0;
+}
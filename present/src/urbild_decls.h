@@ -30,6 +30,14 @@ nFgs_t *nFgsAllocation(group_t *group, long r, char *stem);
 nRgs_t *nRgsAllocation(group_t *group, long r, long s, char *stem);
 void freeNFgs(nFgs_t *nFgs);
 void freeNRgs(nRgs_t *nRgs);
+void nRgsSetThreads(nRgs_t *nRgs, long threads);
+void nRgsSetSliceMemory(nRgs_t *nRgs, long bytes);
+int nRgsSetBlockCache(nRgs_t *nRgs, long blocks);
+void nRgsSetCheckpoint(nRgs_t *nRgs, char *file, double seconds);
+void nRgsSetCompression(nRgs_t *nRgs, boolean compress);
+void nRgsSetTiming(nRgs_t *nRgs, boolean timing);
+int saveNRgsCheckpoint(nRgs_t *nRgs, group_t *group, char *outfile);
+int restoreNRgsCheckpoint(nRgs_t *nRgs, group_t *group, char *infile);
 
 int saveMinimalGenerators(nFgs_t *nFgs, char *outfile, group_t *group);
 int saveUrbildGroebnerBasis(nRgs_t *nRgs, char *outfile, group_t *group);
@@ -47,14 +55,14 @@ void unlinkReducedVector(ngs_t *ngs, rV_t *rv);
 void insertUnreducedVector(ngs_t *ngs, uV_t *uv);
 uV_t *unreducedSuccessor(ngs_t *ngs, uV_t *uv);
 void freeReducedVector(rV_t *rv, ngs_t *ngs);
-rV_t *reducedVector(gV_t *gv, group_t *group);
+rV_t *reducedVector(ngs_t *ngs, gV_t *gv, group_t *group);
 long numberOfHeadyVectors(ngs_t *ngs);
 long dimensionOfDeepestHeady(ngs_t *ngs);
 int insertNewUnreducedVector(ngs_t *ngs, gV_t *gv);
 int insertReducedVector(ngs_t *ngs, rV_t *rv);
 gV_t *duplicate_gVtmp(ngs_t *ngs, boolean radical);
 void unlinkUnreducedVector(ngs_t *ngs, uV_t *uv);
-void freeUnreducedVector(uV_t *uv);
+void freeUnreducedVector(ngs_t *ngs, uV_t *uv);
 uV_t *unreducedVector(ngs_t *ngs, gV_t *gv);
 
 int nRgsInitializeVectors(nRgs_t *nRgs, PTR im, PTR pre, long n,
@@ -101,6 +101,16 @@ regularPermutationAction := function(G)
   return gg;
 end;
 
+# *****************************************************************************
+regularPermutationImages := function(G)
+# Images of the points under the generators of asPermgroup(G), in the
+# order in which they would be written to the .reg file
+  local gg, N;
+  gg := asPermgroup(G);
+  N := Size(gg);
+  return List(GeneratorsOfGroup(gg), g -> List([1..N], j -> j^g));
+end;
+
 # *****************************************************************************
 printGroupInformation := function(name)
   Exec(Concatenation("groupInfo ", name));
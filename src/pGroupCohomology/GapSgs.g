@@ -453,12 +453,13 @@ registrationOfSpecialSubgroup := function(GIdata, specialSubgp,
 end;
 
 ################################################################################
-makeInclusionInfo := function(Gsize, Gname, fldr)
-  local permsl, G, Istump, Glabel, GIdata, specialSubgp, specialSubgpId,
+makeInclusionInfoOfGroup := function(G, Gsize, Gname, fldr)
+  # G must be generated by the permutations of the regular representation
+  # that define the basis of the group algebra
+  local permsl, Istump, Glabel, GIdata, specialSubgp, specialSubgpId,
     CrankPos, Hdata, numMaxels, maxelRankPos, Hpos, i;
   # noms, msNames,
   Glabel := [Gsize, Gname, fldr];
-  G := loadGroup(Glabel);
   Istump := inclusionStump(Glabel);
   # Print("Istump=", Istump, "\n");
   GIdata := [GroupStem(Glabel), Istump, Gsize];
@@ -487,6 +488,12 @@ makeInclusionInfo := function(Gsize, Gname, fldr)
   return;
 end;
 
+################################################################################
+makeInclusionInfo := function(Gsize, Gname, fldr)
+  makeInclusionInfoOfGroup(loadGroup([Gsize, Gname, fldr]), Gsize, Gname, fldr);
+  return;
+end;
+
 ################################################################################
 lePrimePower := function(a, b)
   local al, bl;
@@ -572,6 +579,26 @@ makeThisSmallGroup := function(Gid,fldr)
   return;
 end;
 
+################################################################################
+completeThisSmallGroup := function(Gid, fldr, G)
+  # Used when the basis of the group algebra was constructed by
+  # makeGroupData without calling makeBasis. G is the permutation
+  # group whose generators define that basis.
+  local q, i, Gname;
+  q := Gid[1];
+  i := Gid[2];
+  Gname := Gid2GStem(Gid);
+  if Size(fldr)>0 then
+     ensureDirectoryExists(Concatenation(fldr,"/",datDir(q,i)));
+  else
+     ensureDirectoryExists(datDir(q,i));
+  fi;
+  if not IsAbelian(G) then
+    makeInclusionInfoOfGroup(G, q, Gname, fldr);
+  fi;
+  return;
+end;
+
 ################################################################################
 theUnderlyingPrime := function(q)
   local p, n, l;
@@ -90,6 +90,75 @@ def safe_save(obj, path):
         os.unlink(path)
     save (obj, path)
 
+###################################
+## Locking data in a workspace
+
+class workspace_lock(object):
+    """
+    An exclusive lock on the data of a group in a workspace.
+
+    Different processes that share a workspace, possibly on different
+    hosts, need to avoid computing the same data at the same time.
+    This context manager holds an advisory lock on a file in the
+    sub-folder ``.locks`` of the workspace. It can be entered repeatedly
+    in the same process, but a forked process has to acquire the lock
+    by itself.
+
+    INPUT:
+
+    - ``root`` -- string, the folder of a workspace
+    - ``GStem`` -- string, a name of the data to be locked
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology.auxiliaries import workspace_lock
+        sage: d = tmp_dir()
+        sage: with workspace_lock(d, '8gp3'):
+        ....:     with workspace_lock(d, '8gp3'):
+        ....:         pass
+        ....:     print(workspace_lock._held[os.path.join(d, '.locks', '8gp3')][2])
+        1
+        sage: workspace_lock._held
+        {}
+
+    """
+    _held = {}
+
+    def __init__(self, root, GStem):
+        self.name = os.path.join(root, '.locks', GStem)
+
+    def __enter__(self):
+        import fcntl
+        L = self._held.get(self.name)
+        if L is not None and L[1] == os.getpid():
+            self._held[self.name] = (L[0], L[1], L[2]+1)
+            return self
+        folder = os.path.dirname(self.name)
+        try:
+            os.makedirs(folder)
+        except OSError:
+            if not os.path.isdir(folder):
+                raise
+        fd = os.open(self.name, os.O_RDWR | os.O_CREAT, 0o666)
+        try:
+            # lockf rather than flock, since it works on NFS, too
+            fcntl.lockf(fd, fcntl.LOCK_EX)
+        except BaseException:
+            os.close(fd)
+            raise
+        self._held[self.name] = (fd, os.getpid(), 1)
+        return self
+
+    def __exit__(self, *args):
+        import fcntl
+        fd, pid, n = self._held[self.name]
+        if n > 1:
+            self._held[self.name] = (fd, pid, n-1)
+            return
+        del self._held[self.name]
+        fcntl.lockf(fd, fcntl.LOCK_UN)
+        os.close(fd)
+
 ###################################
 ## Helper for unpickling old data
 
@@ -175,7 +244,20 @@ default_options = (('useMTX',True),
                    ('autoliftElAb',0),
                    ('SingularCutoff',70),
                    ('NrCandidates',1000),
-                   ('use_web',True))
+                   ('use_web',True),
+                   ('threads',1),
+                   ('slice_memory',128),
+                   ('block_cache',4),
+                   ('action_cache',0),
+                   ('subgroup_workers',1),
+                   ('lift_cache',0),
+                   ('lift_cache_policy','lru'),
+                   ('checkpoint',0),
+                   ('pipeline',0),
+                   ('compress',False),
+                   ('lazy_load',False),
+                   ('buchberger_timing',False),
+                   ('sparse_files',False))
 
 coho_options = dict(default_options)
 
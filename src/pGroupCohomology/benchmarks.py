@@ -0,0 +1,229 @@
+# -*- coding: utf-8 -*-
+
+#*****************************************************************************
+#
+#    Reproducible timings for the hot paths of p_group_cohomology
+#
+#    Copyright (C) 2026 agent <agent@local>
+#
+#    This file is part of p_group_cohomology.
+#
+#    p_group_cohomoloy is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 2 of the License, or
+#    (at your option) any later version.
+#
+#    p_group_cohomoloy is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with p_group_cohomoloy.  If not, see <http://www.gnu.org/licenses/>.
+#*****************************************************************************
+
+"""
+Benchmarks for the resolution and cohomology computations
+
+The functions of this module time those parts of the package that
+dominate the computation of a cohomology ring, namely
+
+- the computation of the differentials of a minimal resolution
+  (:meth:`~pGroupCohomology.resolution.RESL.nextDiff`),
+- the composition of chain maps
+  (:meth:`~pGroupCohomology.resolution.RESL.composeChainMaps`),
+- the lift of chain maps with Urbild Groebner bases
+  (:meth:`~pGroupCohomology.resolution.RESL.ugb_liftChainMap`),
+- the construction of autolift data
+  (:meth:`~pGroupCohomology.resolution.RESL.makeAutolift`),
+- products of generators of the cohomology ring, and
+- a complete run of :meth:`~pGroupCohomology.cohomology.COHO.make`.
+
+All data are created from scratch in temporary folders, so that the
+timings neither depend on the user's workspace nor on the database.
+The results are returned as a list of records and can be stored in
+a JSON file, so that timings of different package versions can be
+compared.
+
+AUTHORS:
+
+- agent <agent@local> (2026-10): initial version
+
+"""
+
+from pGroupCohomology.auxiliaries import coho_options, coho_logger
+import os
+
+#: Groups ``(q, n, degree, make)`` used by :func:`run_benchmarks` by default.
+#: The resolution of ``SmallGroup(q,n)`` is computed out to ``degree``;
+#: :meth:`~pGroupCohomology.cohomology.COHO.make` is only run if ``make``
+#: is true, since it takes long for the bigger groups.
+BENCHMARK_GROUPS = [(8,3,8,True), (27,3,6,True), (64,138,6,True),
+                    (128,836,5,False), (243,28,5,False)]
+
+def _record(L, group, path, degree, wt, ct):
+    L.append({'group': group, 'path': path, 'degree': degree,
+              'walltime': wt, 'cputime': ct})
+
+def benchmark_resolution(q, n, degree, folder=None):
+    """
+    Time the computations in the minimal resolution of a group.
+
+    INPUT:
+
+    - ``q, n`` -- integers, the address of a group in the Small Groups library
+    - ``degree`` -- integer, the resolution is computed out to this degree
+    - ``folder`` -- (optional) string, folder for the group data. By default,
+      a temporary folder is used.
+
+    OUTPUT:
+
+    A list of records (dictionaries) with keys ``'group'``, ``'path'``,
+    ``'degree'``, ``'walltime'`` and ``'cputime'``.
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology.benchmarks import benchmark_resolution
+        sage: L = benchmark_resolution(8, 3, 3)
+        sage: sorted(L[0].keys())
+        ['cputime', 'degree', 'group', 'path', 'walltime']
+        sage: sorted(set(r['path'] for r in L))
+        ['autolift', 'composeChainMaps', 'nextDiff', 'ugb_liftChainMap']
+
+    """
+    from sage.all import tmp_dir, walltime, cputime, GF, MatrixSpace
+    from sage.matrix.matrix_gfpn_dense import Matrix_gfpn_dense as MTX
+    from pGroupCohomology.resolution import makeGroupData, RESL
+    if folder is None:
+        folder = tmp_dir()
+    makeGroupData(q, n, folder=folder)
+    gstem = '%dgp%d'%(q,n)
+    gps_folder = os.path.join(folder, gstem)
+    R = RESL(gstem, gps_folder, os.path.join(gps_folder, 'dat'))
+    L = []
+    for d in range(1, degree+1):
+        wt = walltime(); ct = cputime()
+        R.nextDiff()
+        _record(L, gstem, 'nextDiff', d, walltime(wt), cputime(ct))
+    p = R.coef()
+    for d in range(2, degree+1):
+        wt = walltime(); ct = cputime()
+        R.composeChainMaps(R[d], R[d-1], d, d-1, d-2)
+        _record(L, gstem, 'composeChainMaps', d, walltime(wt), cputime(ct))
+    # Lift the cochain dual to the first generator of R_d
+    for d in range(1, degree):
+        C = MTX(MatrixSpace(GF(p), 1, R.rank(d), implementation=MTX), [[1]+[0]*(R.rank(d)-1)])
+        M = R.CochainToChainmap(d, C)[2]
+        wt = walltime(); ct = cputime()
+        R.ugb_liftChainMap(d+1, 1, M)
+        _record(L, gstem, 'ugb_liftChainMap', d, walltime(wt), cputime(ct))
+    for d in range(1, degree+1):
+        wt = walltime(); ct = cputime()
+        R.makeAutolift(d)
+        _record(L, gstem, 'autolift', d, walltime(wt), cputime(ct))
+    return L
+
+def benchmark_cohomology(q, n, products=True, make=True):
+    """
+    Time the computation of a cohomology ring and of products of its generators.
+
+    INPUT:
+
+    - ``q, n`` -- integers, the address of a group in the Small Groups library
+    - ``products`` -- (optional bool, default ``True``) whether to time the
+      products of all pairs of generators.
+    - ``make`` -- (optional bool, default ``True``) whether to time
+      :meth:`~pGroupCohomology.cohomology.COHO.make`. Products can only
+      be timed if ``make`` is true.
+
+    OUTPUT:
+
+    A list of records as in :func:`benchmark_resolution`. The
+    ring is computed from scratch in a temporary workspace; the previous
+    workspace of :func:`~pGroupCohomology.CohomologyRing` is restored
+    afterwards by :meth:`~pGroupCohomology.factory.CohomologyRingFactory.set_workspace`.
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology import CohomologyRing
+        sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+        sage: from pGroupCohomology.benchmarks import benchmark_cohomology
+        sage: ws = CohomologyRing.get_workspace()
+        sage: L = benchmark_cohomology(8, 3)
+        sage: [r['path'] for r in L][:2]
+        ['make', 'product']
+        sage: CohomologyRing.get_workspace() == ws
+        True
+
+    """
+    from sage.all import tmp_dir, walltime, cputime
+    from pGroupCohomology import CohomologyRing
+    L = []
+    if not make:
+        return L
+    old_workspace = CohomologyRing.get_workspace()
+    gstem = '%dgp%d'%(q,n)
+    try:
+        CohomologyRing.set_workspace(tmp_dir())
+        H = CohomologyRing(q, n, from_scratch=True)
+        wt = walltime(); ct = cputime()
+        H.make()
+        _record(L, gstem, 'make', H.knownDeg, walltime(wt), cputime(ct))
+        if products:
+            G = list(H.Gen)
+            for i in range(len(G)):
+                for j in range(i, len(G)):
+                    wt = walltime(); ct = cputime()
+                    X = G[i]*G[j]
+                    _record(L, gstem, 'product', X.deg(), walltime(wt), cputime(ct))
+    finally:
+        CohomologyRing.set_workspace(old_workspace)
+    return L
+
+def run_benchmarks(groups=None, filename=None):
+    """
+    Run the benchmark suite.
+
+    INPUT:
+
+    - ``groups`` -- (optional) list of tuples ``(q, n, degree, make)`` as in
+      :data:`BENCHMARK_GROUPS`, which is the default.
+    - ``filename`` -- (optional) string. If provided, the results are
+      written to this file in JSON format, together with the Sage
+      version, the platform and the relevant options.
+
+    OUTPUT:
+
+    The list of records from :func:`benchmark_resolution` and
+    :func:`benchmark_cohomology`.
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology.benchmarks import run_benchmarks
+        sage: import json
+        sage: fname = os.path.join(tmp_dir(), 'bench.json')
+        sage: L = run_benchmarks([(8,3,3,False)], filename=fname)
+        sage: D = json.load(open(fname))
+        sage: len(D['records']) == len(L)
+        True
+        sage: D['groups']
+        [[8, 3, 3, False]]
+
+    """
+    import json, platform
+    if groups is None:
+        groups = BENCHMARK_GROUPS
+    L = []
+    for q, n, degree, make in groups:
+        coho_logger.info("Benchmark SmallGroup(%d,%d)"%(q,n), None)
+        L.extend(benchmark_resolution(q, n, degree))
+        L.extend(benchmark_cohomology(q, n, make=make))
+    if filename is not None:
+        from sage.version import version
+        D = {'sage_version': version, 'platform': platform.platform(),
+             'options': dict((k, coho_options[k]) for k in ('useMTX', 'sparse', 'threads', 'autolift')),
+             'groups': [list(g) for g in groups],
+             'records': L}
+        with open(filename, 'w') as f:
+            json.dump(D, f, indent=1)
+    return L
@@ -74,3 +74,4 @@ cdef class ChMap(RingHomomorphism):
     cdef object _sing_val # cache for singular representation
     cdef str _sing_domain, _sing_codomain # name of singular rep of domain/codomain
     cdef dict _elim_cache # cache for a ring and an ideal that is used in elimination.
+    cdef dict _cochain_ops # degree -> matrix of the induced map on cochains
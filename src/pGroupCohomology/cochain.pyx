@@ -1568,20 +1568,9 @@ cdef class COCH(RingElement):
             # is likely to be known; otherwise it is computed now.
             TryLift = R.Lifts[(n,n_orig,CM)]
             if TryLift is None:
-                for n_oldmax from n > n_oldmax >= Cdeg:
-                    TryLift = R.Lifts[(n_oldmax,n_orig,CM)]
-                    if TryLift != None:
-                        break
-                if TryLift is None:
-                    ((n2,d2,CM2),n_max) = (R.CochainToChainmap(Cdeg,CM), 2*Cdeg)
-                    R.setLift(C,2*Cdeg)
-                else:
-                    ((n2,d2,CM2),n_max) = TryLift
-                while (n2<n):
-                    (n2,d2,CM2) = R.liftChainMap((n2,d2,CM2))
-                    self.Resl.Lifts[(n2,n_orig,CM)] = ((n2,d2,CM2),n_max)
-            else:
-                ((n2,d2,CM2),n_max) = TryLift
+                R.liftCochains([C], n)
+                TryLift = R.Lifts[(n,n_orig,CM)]
+            ((n2,d2,CM2),n_max) = TryLift
             # compose self with the lift of C
             # OUT = R.composeChainMaps(CM2,CM1,self.deg()+C.deg(),self.deg(),0)
             # the following should be MUCH faster:
@@ -5158,6 +5147,7 @@ cdef class ChMap(RingHomomorphism):
         self._sing_domain = ''
         self._sing_codomain = ''
         self._elim_cache = {}
+        self._cochain_ops = {}
         # self will be induced by a chain map
         # Here, Src denotes the source of the chain map, hence,
         # it corresponds to the codomain of the induced map.
@@ -5995,6 +5985,70 @@ cdef class ChMap(RingHomomorphism):
         OUT.set_immutable
         return OUT
 
+    def cochain_operator(ChMap self, int n):
+        r"""
+        The matrix by which ``self`` maps cochains of degree `n`.
+
+        INPUT:
+
+        ``n`` -- the degree of cochains in the domain of ``self``
+
+        OUTPUT:
+
+        An immutable matrix, whose `i`-th row is the image of the `i`-th
+        standard cochain of degree `n`. Hence, if the rows of a matrix `M`
+        are cochains of degree `n`, then the rows of `M` times this matrix
+        are their images.
+
+        NOTE:
+
+        The matrix is cached, and the cache is extended with each degree
+        that is requested. So, applying ``self`` to many cochains of the
+        same degree only costs one matrix multiplication.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(8,3)
+            sage: H.make()
+            sage: r = H.restriction_maps()[2][1]
+            sage: O = r.cochain_operator(2)
+            sage: O.dimensions()
+            (3, 3)
+            sage: all(O[i] == r((2,i)).MTX()[0] for i in range(3))
+            True
+            sage: r.cochain_operator(2) is O
+            True
+
+        """
+        cdef MTX OUT = self._cochain_ops.get(n)
+        if OUT is not None:
+            return OUT
+        if (n-self.Deg < 0):
+            raise IndexError("Degree must be at least %d"%(self.Deg))
+        if self.Deg > 0:
+            base = n - self.Deg
+        else:
+            base = n
+        while (base >= len(self.Data)):
+            self.lift()
+        cdef MTX selfMTX = self[base]
+        cdef int s_rk = self.Src.rank(n-self.Deg)
+        cdef int t_rk = self.Tgt.rank(n)
+        if (selfMTX.Data.Nor<>s_rk*t_rk):
+            raise RuntimeError("Theoretical Error")
+        OUT = new_mtx(MatAlloc(self.Src.coef(), t_rk, s_rk), selfMTX)
+        cdef int i, j, cf
+        for i from 0 <= i < s_rk:
+            for j from 0 <= j < t_rk:
+                cf = selfMTX.get_unsafe_int(i*t_rk+j, 0)
+                if cf:
+                    OUT[j,i] = cf
+        OUT.set_immutable()
+        self._cochain_ops[n] = OUT
+        return OUT
+
     def __mul__(ChMap self, x):
         """
         CM*Co: CM of type <ChMap>, Co of type <COCH> or <ChMap>.
@@ -6026,7 +6080,7 @@ cdef class ChMap(RingHomomorphism):
         cdef ChMap OUT
         cdef MTX OUT_M,xMTX,selfMTX
         cdef COCH OUT_C
-        cdef int i,j, t_rk,s_rk,cf,xLj, i_trk
+        cdef int i,j, t_rk,s_rk
         cdef long X
         cdef list L=[]
         cdef int RK, Rk, rk
@@ -6124,30 +6178,16 @@ cdef class ChMap(RingHomomorphism):
                     outname = '('+x.name()+')_'
                 return MODCOCH(self.codomain(), singular('NF(%s(%s),std(0))'%(Sself.name(),Sx.name())), deg=x.deg(), name=outname, S=singular)
 
-            if self.Deg > 0:
-                base = x.deg() - self.Deg
-            else:
-                base = x.deg()
-            while (base >= len(self.Data)):
-                self.lift()
-            selfMTX = self.__getitem__(base)
+            selfMTX = self.cochain_operator(x.deg())
             xMTX = x.MTX()
-            s_rk = self.Src.rank(x.deg()-self.Deg)
-            t_rk = self.Tgt.rank(x.deg())
-            if (selfMTX.Data.Nor<>s_rk*t_rk):
-                raise RuntimeError("Theoretical Error")
+            t_rk = selfMTX.Data.Nor
+            s_rk = selfMTX.Data.Noc
             if (xMTX.Data.Noc<>t_rk):
                 raise RuntimeError("Theoretical Error")
-            OUT_M = new_mtx(MatAlloc(self.Src.coef(), 1,s_rk), xMTX)
-            for i from 0 <= i < s_rk:
-                cf = 0
-                i_trk = i*t_rk
-                for j from 0 <= j < t_rk:
-                    xLj = xMTX.get_unsafe_int(0,j)
-                    if xLj:
-                        cf = cf + xLj*selfMTX.get_unsafe_int(i_trk,0)
-                    i_trk+=1
-                OUT_M[0,i]=cf
+            if s_rk and t_rk:
+                OUT_M = xMTX._multiply_strassen(selfMTX)
+            else:
+                OUT_M = new_mtx(MatAlloc(self.Src.coef(), 1,s_rk), xMTX)
             OUT_M.set_immutable()
             if self._name is not None:
                 return COCH(self._parent._codomain,x.deg()-self.Deg, self._name+'('+x.name()+')', OUT_M)
@@ -6503,12 +6543,9 @@ cdef class ChMap(RingHomomorphism):
         if coho_options['useMTX']:
             coho_logger.debug("> > Construct MTX matrix for elimination", self)
             tmpL = []
+            tmpM = self.cochain_operator(d)
             for i from 0 <= i < RK:
-                ttmpL = []
-                tmpM = self[d]
-                for j from 0 <= j < src_rk:
-                    ttmpL.append(tmpM[j*RK+i,0])
-                tmpL.append(ttmpL + i*[0]+[1]+(RK-i-1)*[0])
+                tmpL.append(tmpM._rowlist_(i) + i*[0]+[1]+(RK-i-1)*[0])
             tmpMTX = rawMatrix(p, tmpL)
             M = new_mtx(tmpMTX, None)
         else:
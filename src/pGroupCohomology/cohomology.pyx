@@ -608,11 +608,29 @@ cdef Matrix_t *nil_preimages(list Maps, list Cochains) except NULL:
     for imC in ImageList:
         memcpy(p_imC, imC.Data.Data.Data, imC.Data.Data.RowSize)
         p_imC += imC.Data.Data.RowSize
-    for C in Cochains:
+    # The images of the remaining cochains under a restriction map are
+    # obtained by a single multiplication with its cochain operator.
+    cdef MTX Rows, Img
+    cdef PTR p_Img
+    cdef size_t col_offset = 0
+    cdef int k
+    if Cochains:
+        Rest = Maps[0]
+        Rows = new_mtx(MatAlloc(Field, len(Cochains), Rest.Tgt.rank(d+Rest.Deg)), None)
+        for k, C in enumerate(Cochains):
+            if isinstance(C, COCH):
+                memcpy(MatGetPtr(Rows.Data, k), (<COCH>C).Data.Data.Data, Rows.Data.RowSize)
+            else:
+                Rows[k, C[1]] = 1
         for Rest in Maps:
-            imC = Rest(C)
-            memcpy(p_imC, imC.Data.Data.Data, imC.Data.Data.RowSize)
-            p_imC += imC.Data.Data.RowSize
+            Img = Rows._multiply_strassen(Rest.cochain_operator(d+Rest.Deg))
+            p_Img = Img.Data.Data
+            p_imC = Images.Data + LongRowSize + col_offset
+            for k in range(Img.Data.Nor):
+                memcpy(p_imC, p_Img, Img.Data.RowSize)
+                p_imC += LongRowSize
+                p_Img += Img.Data.RowSize
+            col_offset += Img.Data.RowSize
     # nil radical for elementary abelian groups is trivial
     if Field==2:
         return MatNullSpace__(Images)
@@ -1144,6 +1162,34 @@ def is_filter_regular_parameter_system(I, FRS):
         except:
             pass
 
+def _make_subgroup_ring(q, nr, deg):
+    """
+    Compute and store the cohomology ring of ``SmallGroup(q,nr)`` out to degree ``deg``.
+
+    This is run in a worker process by :meth:`COHO.InitSubgroups`, if
+    ``CohomologyRing.global_options`` provides more than one
+    ``subgroup_workers``. The result is stored in the workspace,
+    from where :meth:`COHO.InsertSubgroup` reloads it.
+
+    TESTS::
+
+        sage: from pGroupCohomology import CohomologyRing
+        sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+        sage: from pGroupCohomology.cohomology import _make_subgroup_ring
+        sage: _make_subgroup_ring(4, 2, 3)
+        True
+        sage: H = CohomologyRing(4, 2, Subgroups=False, websource=False)
+        sage: H.knownDeg >= 3
+        True
+
+    """
+    from pGroupCohomology import CohomologyRing
+    h = CohomologyRing(q, nr, Subgroups=False, websource=False)
+    h.make()
+    while h.knownDeg < deg:
+        h.next(Forced=True, KeepDecomposables=True)
+    return True
+
 ####################################################################
 ####################################################################
 ## The COHO extension class
@@ -3703,6 +3749,25 @@ class COHO(Ring):
             sage: 'subgps' in K.__dict__
             True
 
+        With the option ``lazy_load``, also the resolution and the monomial
+        tables are only read from the workspace when they are needed,
+        which saves a lot of time and memory for read-only queries::
+
+            sage: CohomologyRing.global_options('warn', 'lazy_load')
+            sage: K = COHO()
+            sage: K.__setstate__(H.__getstate__())
+            sage: [a in K.__dict__ for a in ('Resl', 'Monomials', 'StdMon')]
+            [False, False, False]
+            sage: K.poincare_series()
+            1/(t^2 - 2*t + 1)
+            sage: K.Resl.coef()
+            2
+            sage: sorted(K.Monomials.keys()) == sorted(H.Monomials.keys())
+            True
+            sage: [a in K.__dict__ for a in ('Resl', 'Monomials', 'StdMon')]
+            [True, True, False]
+            sage: CohomologyRing.global_options('nolazy_load')
+
         """
         if len(s)==34:
             RestrMaps,degvec,CElPos,CenterRk,gps_folder,Rel,res_folder,subgps,dat_folder,Triangular,inc_folder,lastRel,MaxelPos,MaxelRk,pRank,knownDeg,RelG,Gen,StdMon,NilBasis,SingularTime,completed,Monomials,suffDeg,Automatic,RelGName,NumSubgps,GStem,Resl,firstOdd,DG,Dickson,alpha, Dict = s
@@ -3712,10 +3777,12 @@ class COHO(Ring):
         else:
             raise ValueError("wrong number of arguments")
         opts = dict(coho_options)
+        lazy = opts.get('lazy_load')
         coho_options['autolift']=False
         coho_options['save']=False
         coho_options['reload']=True
         cdef int p
+        cdef dict lazy_state = {}
         # In contrast to the data files, our folders are not supposed to be symlinks
         # Hence, here it is realpath
         res_folder = os.path.realpath(res_folder)
@@ -3777,24 +3844,14 @@ class COHO(Ring):
 
             if isinstance(Resl, (str, unicode)):
                 Resl = str(Resl)
-                if (oldroot is not None):
-                    coho_options['@oldroot@'] = oldroot
-                coho_options['@newroot@'] = root
-                try:
-                    if Resl.endswith('.sobj'):
-                        self.Resl = load(os.path.join(root,Resl))  # realpath here?
-                    else:
-                        self.Resl = load(os.path.join(root,Resl+'.sobj'))  # realpath here?
-                except (OSError, IOError, RuntimeError):
-                    raise IOError("Unable to read resolution saved at "+os.path.join(root,Resl))
-                try:
-                    del coho_options['@newroot@']
-                except KeyError:
-                    pass
-                ## The resolution is in a readable file.
-                ## We don't need to relocate the data right now.
-                if '@oldroot@' in coho_options:
-                    del coho_options['@oldroot@']
+                if lazy and Gen:
+                    ## The resolution is only read when it is needed.
+                    ## The field is known from the generators.
+                    lazy_state['Resl'] = (Resl, root, oldroot)
+                    p = Gen[0][2].base_ring().characteristic()
+                else:
+                    self._load_resolution(Resl, root, oldroot)
+                    p = self.Resl.coef()
             else:
                 MaxDeg = max([0]+[X[0] for X in Gen])
                 self.Resl = None
@@ -3807,8 +3864,9 @@ class COHO(Ring):
                     print(Resl[4])
                     print(type(Resl[4]))
                     raise
-            (<RESL>self.Resl).G_Alg.groupname = self.printed_group_name()
-            Ring.__init__(self,GF(self.Resl.coef()))
+                (<RESL>self.Resl).G_Alg.groupname = self.printed_group_name()
+                p = self.Resl.coef()
+            Ring.__init__(self,GF(p))
 
             self.firstOdd = firstOdd
             n = self.knownDeg
@@ -3829,8 +3887,11 @@ class COHO(Ring):
                 self.Triangular[i] = [COCH(self,X[0],X[1],X[2], is_polyrep=True) for X in Tr]
             self.NilBasis = NilBasis
             if isinstance(Monomials, (str, unicode)):
-                self.Monomials = {'bla':1}
-                self.importMonomials()
+                if lazy:
+                    lazy_state['Monomials'] = True
+                else:
+                    self.Monomials = {'bla':1}
+                    self.importMonomials()
             else:
                 self.Monomials = {}
                 for i,Mo in Monomials:
@@ -3873,7 +3934,6 @@ class COHO(Ring):
             ################
             # Finally, we reconstruct the attributes in Singular:
             # GenS, StdMon; a ring and the relation ideal in singular.
-            p = self.Resl.coef()
             if p!=2:
                 singular.LIB("ncall.lib")
             singular.LIB('general.lib')
@@ -3895,7 +3955,7 @@ class COHO(Ring):
                 else:
                     self._makeOrderMatrix_()
                     singular.eval('ring tmp = %d,(%s),M(%sM)'%(p, ','.join([x.name() for x in self.Gen]), self.prefix))
-                if self.Resl.coef()!=2:   # non-commutative case
+                if p!=2:   # non-commutative case
                     singular.eval('degBound = 0')
                     singular.eval('def %sr(%d) = superCommutative(%d,%d)'%(self.prefix,n,self.firstOdd+1, len(self.Gen)))
                 else:
@@ -3913,21 +3973,132 @@ class COHO(Ring):
                         singular.eval('ideal %sI'%(self.prefix))
                 singular.eval(('ideal %sDG = '%self.prefix)+','.join(DG))
 
-            self.StdMon = {0:{'1':singular('1')}}
-            for nkey,StdMonN in StdMon: # There will only be a standard monomial, if
-                                        # there are generators. Hence, IF we are defining
-                                        # an ideal below, it is granted that the basering
-                                        # is defined.
-                self.StdMon[nkey]={}
-                for monkey,STD in StdMonN:
-                    if monkey!='1':
-                        self.StdMon[nkey][monkey] = singular.ideal(STD)
-                    else:
-                        self.StdMon[nkey][monkey] = singular('1')
+            if lazy and completed and Gen:
+                ## The ring will not grow any further, hence, the
+                ## ideals can later be created in the ring of degree n
+                lazy_state['StdMon'] = (n, StdMon)
+            else:
+                self._make_standard_monomials(StdMon)
+            if lazy_state:
+                self.__dict__['_lazy_state'] = lazy_state
         finally:
             coho_options.clear()
             coho_options.update(opts)
 
+    def _load_resolution(self, Resl, root, oldroot=None):
+        """
+        Read the resolution of ``self`` from a file.
+
+        INPUT:
+
+        - ``Resl`` -- the location of the resolution, relative to ``root``
+        - ``root`` -- the folder in which the ring data are rooted
+        - ``oldroot`` -- (optional) the root from which the data were moved
+
+        NOTE:
+
+        This is used by :meth:`__setstate__`, and by :meth:`__getattr__`
+        if the resolution was not read when loading ``self`` with the option
+        ``lazy_load``.
+
+        TESTS::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(8,3)
+            sage: H.make()
+            sage: R = H.Resl
+            sage: H._load_resolution(os.path.join(H.GStem,'dat','R'+H.GStem), H.root)
+            sage: H.Resl.coef(), H.Resl.deg() == R.deg()
+            (2, True)
+
+        """
+        opts = dict(coho_options)
+        coho_options['autolift']=False
+        coho_options['save']=False
+        coho_options['reload']=True
+        if (oldroot is not None):
+            coho_options['@oldroot@'] = oldroot
+        coho_options['@newroot@'] = root
+        try:
+            try:
+                if Resl.endswith('.sobj'):
+                    self.Resl = load(os.path.join(root,Resl))  # realpath here?
+                else:
+                    self.Resl = load(os.path.join(root,Resl+'.sobj'))  # realpath here?
+            except (OSError, IOError, RuntimeError):
+                raise IOError("Unable to read resolution saved at "+os.path.join(root,Resl))
+            ## The resolution is in a readable file.
+            ## We don't need to relocate the data right now.
+        finally:
+            coho_options.clear()
+            coho_options.update(opts)
+        (<RESL>self.Resl).G_Alg.groupname = self.printed_group_name()
+
+    def _make_standard_monomials(self, StdMon):
+        """
+        Create the ideals of standard monomials in Singular.
+
+        INPUT:
+
+        ``StdMon`` -- a list of standard monomial data as returned by :meth:`__getstate__`.
+
+        NOTE:
+
+        The ideals are created in the current basering.
+
+        """
+        self.StdMon = {0:{'1':singular('1')}}
+        for nkey,StdMonN in StdMon: # There will only be a standard monomial, if
+                                    # there are generators. Hence, IF we are defining
+                                    # an ideal below, it is granted that the basering
+                                    # is defined.
+            self.StdMon[nkey]={}
+            for monkey,STD in StdMonN:
+                if monkey!='1':
+                    self.StdMon[nkey][monkey] = singular.ideal(STD)
+                else:
+                    self.StdMon[nkey][monkey] = singular('1')
+
+    def _materialise(self, key):
+        """
+        Reconstruct an attribute that was not read when loading ``self`` with the option ``lazy_load``.
+
+        INPUT:
+
+        ``key`` -- one of ``'Resl'``, ``'Monomials'`` and ``'StdMon'``
+
+        OUTPUT:
+
+        ``True``, if the attribute was reconstructed, ``False`` if it
+        was already known.
+
+        NOTE:
+
+        This is called by :meth:`__getattr__`. There is no need to call it directly.
+
+        """
+        cdef dict lazy_state = self.__dict__.get('_lazy_state')
+        if not lazy_state or key not in lazy_state:
+            return False
+        data = lazy_state.pop(key)
+        if not lazy_state:
+            del self.__dict__['_lazy_state']
+        coho_logger.debug("Reading %s on demand", self, key)
+        if key == 'Resl':
+            self._load_resolution(*data)
+        elif key == 'Monomials':
+            self.Monomials = {'bla':1}
+            self.importMonomials()
+        elif key == 'StdMon':
+            n, StdMon = data
+            br = singular.eval('nameof(basering)')
+            singular.eval('setring %sr(%d)'%(self.prefix,n))
+            self._make_standard_monomials(StdMon)
+            if br and br != '%sr(%d)'%(self.prefix,n) and singular.eval('defined(%s)'%br)=='1':
+                singular.eval('setring %s'%br)
+        return True
+
     def autosave_name(self):
         """
         Return the name of the file under which ``self`` is automatically saved.
@@ -4082,6 +4253,7 @@ class COHO(Ring):
                 MonExp = [[int(y.strip()) for y in x.split(',')] for x in \
                           [s.strip() for s in (singular.eval('for (i=1;i<=ncols(Mon);i++) { print(leadexp(Mon[i]));print(\";\");}')+'\n').split(';')] if x]
                 lenMonExp = len(MonExp)
+                self._lift_right_factors(n, MonExp)
 
                 #######################################
                 # Perform the products
@@ -4872,6 +5044,10 @@ Minimal list of algebraic relations:
         if (key=="subgps") and ('SUBGPS' in self._property_dict):
             self.reconstructSubgroups()
             return self.subgps
+        # After loading with the option 'lazy_load', the resolution and the
+        # monomial tables are only read when they are required.
+        if key in ('Resl', 'Monomials', 'StdMon') and self._materialise(key):
+            return self.__dict__[key]
         if (key=="RestrMaps"):
             if  ('SUBGPS' in self._property_dict or 'RESTRMAPS' in self._property_dict):
                 self.reconstructSubgroups()
@@ -6587,11 +6763,52 @@ Minimal list of algebraic relations:
         """
         # Assume: All lifts have been performed before
         cdef int lenoldV = len(expV)
-        cdef int i, s_o, s_e, sml
+        cdef int i, sml
         newKey = ''.join([expV[i]*(self.Gen[i].name()) for i in range(lenoldV)])
         if newKey in self.Monomials:
             return self.Monomials[newKey]
         cdef list oldV = list(tuple(expV))# copy the list
+        sml = self._smallest_factor(oldV)
+
+        # Compute the product Gen[sml]*(the rest)
+        oldV[sml]-=1
+        cdef COCH Coch
+        cdef RESL R
+        R=self.Resl
+        if max(oldV)==0: # the monomial is a single variable
+            return self.Gen[sml]
+        Coch = self.Gen[sml]*self.MonToProd(oldV)
+        self.Monomials[newKey] = Coch
+        self.Resl.setLift(Coch, Coch.deg()+self.degvec[sml])
+        return Coch
+
+    def _smallest_factor(self, list oldV):
+        """
+        Return the index of the generator that :meth:`MonToProd` splits off a monomial.
+
+        INPUT:
+
+        ``oldV``: a non-zero list of exponents
+
+        OUTPUT:
+
+        The index of the generator of smallest degree among the even
+        resp. the odd generators occuring in the monomial.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(8,3)
+            sage: H.make()
+            sage: H.MonToProd([0,2,1])
+            (b_1_0)*((b_1_0)*(b_1_1)): 3-Cocycle in H^*(D8; GF(2))
+            sage: H._smallest_factor([0,2,1])
+            1
+
+        """
+        cdef int lenoldV = len(oldV)
+        cdef int i, s_o, s_e, sml
         # find the factor of smallest even/odd degree
         for i from 0 <= i < self.firstOdd:
             if oldV[i]:
@@ -6619,18 +6836,55 @@ Minimal list of algebraic relations:
                 sml = s_o
             else:
                 sml = s_e
+        return sml
 
-        # Compute the product Gen[sml]*(the rest)
-        oldV[sml]-=1
-        cdef COCH Coch
-        cdef RESL R
-        R=self.Resl
-        if max(oldV)==0: # the monomial is a single variable
-            return self.Gen[sml]
-        Coch = self.Gen[sml]*self.MonToProd(oldV)
-        self.Monomials[newKey] = Coch
-        self.Resl.setLift(Coch, Coch.deg()+self.degvec[sml])
-        return Coch
+    def _lift_right_factors(self, int n, list MonExp):
+        """
+        Lift the right factors of the products of the given monomials out to degree `n`.
+
+        INPUT:
+
+        - ``n``: the degree of the monomials
+        - ``MonExp``: a list of exponent vectors of monomials
+
+        NOTE:
+
+        :meth:`MonToProd` computes a monomial as the product of a generator
+        with a monomial of lower degree, which needs to be lifted to degree `n`.
+        The lifts of all these factors are computed at once, by
+        :meth:`~pGroupCohomology.resolution.RESL.liftCochains`, so that
+        the subsequent products find them.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(8,3)
+            sage: H.make()
+            sage: H._lift_right_factors(8, [[0,7,1]])
+            sage: C = H.MonToProd([0,6,1])
+            sage: H.resolution().getLifts()[(8,7)][C.MTX()][0][0]
+            8
+
+        """
+        cdef list L = []
+        cdef set Known = set()
+        cdef list oldV
+        cdef int i, sml
+        for expV in MonExp:
+            newKey = ''.join([expV[i]*(self.Gen[i].name()) for i in range(len(expV))])
+            if newKey in self.Monomials:
+                continue
+            oldV = list(expV)
+            sml = self._smallest_factor(oldV)
+            oldV[sml] -= 1
+            if max(oldV)==0:
+                continue
+            C = self.MonToProd(oldV)
+            if id(C) not in Known:
+                Known.add(id(C))
+                L.append(C)
+        self.Resl.liftCochains(L, n)
 
     #####################
     ## Compute the standard monomials in degree n and store them in Singular under
@@ -7150,6 +7404,16 @@ Minimal list of algebraic relations:
             sage: H.subgpDickson
             {(4, 2): [c_1_1: 1-Cocycle in H^*(SmallGroup(4,2); GF(2))]}
 
+        The subgroup rings can be computed in worker processes, provided
+        by the global option ``subgroup_workers``. The results are stored
+        in the workspace and then inserted as above::
+
+            sage: CohomologyRing.global_options(subgroup_workers=2)
+            sage: H2 = CohomologyRing(8,3, from_scratch=True)
+            sage: sorted(H2.subgroups().items())
+            [((2, 1), H^*(SmallGroup(2,1); GF(2))), ((4, 2), H^*(SmallGroup(4,2); GF(2)))]
+            sage: CohomologyRing.global_options(subgroup_workers=1)
+
         Finally, we show location and content of the GAP-readable
         file that defines the subgroup structure::
 
@@ -7190,6 +7454,18 @@ Minimal list of algebraic relations:
         ## insert the special subgroups
 #~         for i in xrange(1,NumSubgps+1):
 #~             self.InsertSubgroup(Integer(L[2][i][1]),Integer(L[2][i][2]),i)
+        # Worker processes hand their results over through the workspace,
+        # hence this requires that data are saved.
+        workers = coho_options.get('subgroup_workers', 1)
+        if workers > 1 and coho_options['save']:
+            Ids = sorted(set([(x[0].sage(), x[1].sage()) for x in L[1]]).difference(self.subgps.keys()))
+            if len(Ids) > 1:
+                coho_logger.info("Computing %d subgroup rings in %d worker processes", self, len(Ids), min(workers, len(Ids)))
+                from sage.parallel.decorate import parallel
+                CurrDeg = self.Resl.deg()
+                for (args, kwds), result in parallel(p_iter='fork', ncpus=min(workers, len(Ids)))(_make_subgroup_ring)([(q, nr, CurrDeg) for q,nr in Ids]):
+                    if result is not True:
+                        coho_logger.warning("Worker for SmallGroup(%d,%d) failed, it will be computed here", self, args[0], args[1])
         for i,x in enumerate(L[1]):
             self.InsertSubgroup(x[0].sage(), x[1].sage(), i+1)
         if self.useElimination is None: # determine it by a heuristic
@@ -7795,20 +8071,17 @@ Minimal list of algebraic relations:
         self.Resl.free_ugb()
         coho_logger.debug("> Evaluating restrictions of ring generators", self)
         cdef int sum_rk = add([self.RestrMaps[X[0]][1].src().rank(d) for X in L])
-        cdef int src_rk
         cdef list ttmpL
         cdef list tmpL
         cdef Matrix_t *tmpMTX
         if coho_options['useMTX']:
             coho_logger.debug("> > Construct MTX matrix for elimination", self)
             tmpL = []
+            Ops = [self.RestrMaps[X[0]][1].cochain_operator(d) for X in L]
             for i from 0 <= i < RK:
                 ttmpL = []
-                for X in L:
-                    tmpM = self.RestrMaps[X[0]][1][d]
-                    src_rk = self.RestrMaps[X[0]][1].src().rank(d)
-                    for j from 0 <= j < src_rk:
-                        ttmpL.append(tmpM[j*RK+i,0])
+                for tmpM in Ops:
+                    ttmpL.extend(tmpM._rowlist_(i))
                 tmpL.append(ttmpL + i*[0]+[1]+(RK-i-1)*[0])
             tmpMTX = rawMatrix(p, tmpL)
             M = new_mtx(tmpMTX, None)
@@ -10162,7 +10435,11 @@ is an error. Please inform the author!""")
         NOTE:
 
         The singular representation of ``self`` is cached until the
-        ring structure changes.
+        ring structure changes, that is, until a generator or a relation
+        is added. It is then defined by the relation ideal that is kept
+        in the Singular session, after :meth:`make_groebner` has extended
+        its Groebner basis by the new relations. So, neither the ring nor
+        the relations are sent to Singular again.
 
         TESTS::
 
@@ -10198,6 +10475,16 @@ is an error. Please inform the author!""")
             sage: R2 is singular(H)
             True
 
+        If the cached ring is lost, it is created again without
+        computing a Groebner basis::
+
+            sage: del H._SINGULAR_
+            sage: CohomologyRing.global_options('info')
+            sage: R3 = singular(H)
+            sage: CohomologyRing.global_options('warn')
+            sage: R3 is singular(H)
+            True
+
         """
         if not self.Gen:
             raise ValueError("We don't know any generator of %s yet"%repr(self))
@@ -10246,6 +10533,12 @@ is an error. Please inform the author!""")
                 Computing Groebner basis up to degree 5
             sage: len(H.RelG)
             8
+
+        The Groebner basis is kept in the Singular session, together
+        with its degree bound. So, it is not recomputed if neither the
+        relation ideal nor the degree bound have changed::
+
+            sage: H.make_groebner(4)
             sage: H.make_groebner()
                 Computing complete Groebner basis
 
@@ -10256,33 +10549,118 @@ is an error. Please inform the author!""")
 
             sage: H.make_groebner(5)
 
+        The Groebner basis is stored in ``H.RelG``, so that it can be
+        reconstructed after a crash of Singular::
+
+            sage: CohomologyRing.global_options('warn')
+            sage: H = CohomologyRing(8,3, from_scratch=True)
+            sage: H.make()
+            sage: singular.quit()
+            sage: H.reconstruct_singular()
+            H^*(D8; GF(2)):
+                Reconstructing data in the Singular interface
+            sage: H.RelG
+            ['b_1_0*b_1_1']
+            sage: H.set_ring()
+            sage: singular.eval('print(%sI)'%H.prefix)
+            'b_1_0*b_1_1'
+
         """
         if self.completeGroebner:
             return
+        self.set_ring()
+        # A Groebner basis of the first k generators of the relation ideal,
+        # computed out to degree gbd (0 meaning no bound), is kept in the
+        # Singular session. If the relation ideal has only been extended
+        # since then, we continue from that Groebner basis.
+        cdef int k = 0
+        cdef int gbd = 0
+        cdef int size = int(singular.eval('ncols(%sI)'%(self.prefix)))
+        if singular.eval('defined(%sIGB)'%(self.prefix))=='1':
+            k = int(singular.eval('ncols(%sIGB)'%(self.prefix)))
+            gbd = int(singular.eval('%sIGBd'%(self.prefix)))
+            if k==0 or k>size or (gbd and (d==0 or gbd<d)) or singular.eval('matrix(ideal(%sI[1..%d]))==matrix(%sIGB)'%(self.prefix,k,self.prefix))!='1':
+                k = 0
+        if k and k==size:
+            self.RelG = [s.strip() for s in singular.eval('print(%sI)'%(self.prefix)).split(',')]
+            self.setprop('completeGroebner', gbd==0)
+            return
+        if k and self.base_ring().characteristic()!=2:
+            # Incremental standard bases are only used in the commutative case
+            k = 0
         if d==0:
             coho_logger.info("Computing complete Groebner basis", self)
         else:
             coho_logger.info("Computing Groebner basis up to degree %d"%d, self)
-        if self.useSlimgb:
-            coho_logger.debug("> using slimgb", self)
-        elif self.useStd:
-            coho_logger.debug("> using std", self)
         dgb = singular.eval('degBound', self)
         singular.eval('degBound = %d'%(d))
-        self.set_ring()
-        if self.useSlimgb:
-            singular.eval('%sI=slimgb(%sI)'%(self.prefix, self.prefix))
-        elif self.useStd:
-            singular.eval('%sI=std(%sI)'%(self.prefix, self.prefix))
+        if k:
+            coho_logger.debug("> extending a Groebner basis by %d elements"%(size-k), self)
+            singular.eval('%sI=std(%sIGB,ideal(%sI[%d..%d]))'%(self.prefix, self.prefix, self.prefix, k+1, size))
         else:
-            singular.eval('%sI=groebner(%sI)'%(self.prefix, self.prefix))
+            if self.useSlimgb:
+                coho_logger.debug("> using slimgb", self)
+            elif self.useStd:
+                coho_logger.debug("> using std", self)
+            if self.useSlimgb:
+                singular.eval('%sI=slimgb(%sI)'%(self.prefix, self.prefix))
+            elif self.useStd:
+                singular.eval('%sI=std(%sI)'%(self.prefix, self.prefix))
+            else:
+                singular.eval('%sI=groebner(%sI)'%(self.prefix, self.prefix))
         singular.eval('degBound = '+dgb)
+        if singular.eval('defined(%sIGB)'%(self.prefix))=='1':
+            singular.eval('%sIGB = %sI'%(self.prefix, self.prefix))
+            singular.eval('%sIGBd = %d'%(self.prefix, d))
+        else:
+            singular.eval('ideal %sIGB = %sI'%(self.prefix, self.prefix))
+            singular.eval('int %sIGBd = %d'%(self.prefix, d))
         self.RelG = [s.strip() for s in singular.eval('print(%sI)'%(self.prefix)).split(',')]
         if d==0:
             self.setprop('completeGroebner',True)
         else:
             self.setprop('completeGroebner',False)
 
+    def _transfer_groebner_basis(self, int m, int n):
+        """
+        Keep the Groebner basis from :meth:`make_groebner` when the ring of degree ``n`` replaces the ring of degree ``m``.
+
+        NOTE:
+
+        This is done in :meth:`next`, after the relation ideal was mapped
+        to the new ring, which must be the current basering. The Groebner
+        basis is only kept if there is no new generator, since otherwise
+        the monomial ordering changes.
+
+        TESTS:
+
+        The Groebner basis and its degree bound are stored in the
+        Singular session::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(27,3, from_scratch=True)
+            sage: H.make(3)
+            sage: H.make_groebner(5)
+            sage: H.set_ring()
+            sage: singular.eval('%sIGBd'%H.prefix)
+            '5'
+
+        """
+        singular.eval('setring %sr(%d)'%(self.prefix,m))
+        has_GB = singular.eval('defined(%sIGB)'%(self.prefix))=='1'
+        if has_GB:
+            gbd = singular.eval('%sIGBd'%(self.prefix))
+        singular.eval('setring %sr(%d)'%(self.prefix,n))
+        if not has_GB or singular.eval('nvars(%sr(%d))==nvars(%sr(%d))'%(self.prefix,m,self.prefix,n))!='1':
+            return
+        if singular.eval('defined(%sIGB)'%(self.prefix))=='1':
+            singular.eval('%sIGB = imap(%sr(%d),%sIGB)'%(self.prefix,self.prefix,m,self.prefix))
+            singular.eval('%sIGBd = %s'%(self.prefix,gbd))
+        else:
+            singular.eval('ideal %sIGB = imap(%sr(%d),%sIGB)'%(self.prefix,self.prefix,m,self.prefix))
+            singular.eval('int %sIGBd = %s'%(self.prefix,gbd))
+
 #####################################################################
 ## Ring theoretic properties of the cohomology ring
 #####################################################################
@@ -12299,6 +12677,7 @@ is an error. Please inform the author!""")
                 MonExp = [[int(y.strip()) for y in x.split(',')] for x in \
                           [s.strip() for s in (singular.eval('for (i=1;i<=ncols(Mon);i++) { print(leadexp(Mon[i]));print(\";\");}')+'\n').split(';')] if x]
                 lenMonExp = len(MonExp)
+                self._lift_right_factors(n, MonExp)
 
                 #######################################
                 # Perform the products
@@ -12651,6 +13030,7 @@ is an error. Please inform the author!""")
                 self.StdMon[n][X.Name]=singular.ideal(X.Name)
         if n>1:
             singular.eval('ideal %sI = imap(%sr(%d),%sI)'%(self.prefix,self.prefix,n-1,self.prefix))
+            self._transfer_groebner_basis(n-1, n)
             # keep track of decomposable generators --
             # We need them for lifting the Dickson invariants!
             singular.eval('ideal %sDG = imap(%sr(%d),%sDG)'%(self.prefix,self.prefix,n-1,self.prefix))
@@ -12755,6 +13135,19 @@ is an error. Please inform the author!""")
              a_2_1*a_1_0,
              a_2_1^2]
 
+        With the option ``pipeline``, the differentials of the resolution
+        are computed in a background process while the ring structure in
+        the current degree is determined. The result does not change::
+
+            sage: CohomologyRing.global_options(pipeline=1)
+            sage: H2 = CohomologyRing(32,5, from_scratch=True, GStem='32gp5pipe')
+            sage: H2.make()
+            sage: CohomologyRing.global_options(pipeline=0)
+            sage: H2.resolution().rank(H2.knownDeg) == H.resolution().rank(H2.knownDeg)
+            True
+            sage: H2.rels() == H.rels()
+            True
+
         """
         if max_deg == 0:
             return
@@ -12788,12 +13181,26 @@ is an error. Please inform the author!""")
             coho_logger.info("We have the degree bound %d", self, self.suffDeg)
         if max_deg>0:
             coho_logger.info("We will compute at most up to degree %d",self, max_deg)
-        while (1):
-            coho_logger.info('Start computation in Degree %d', self, self.knownDeg+1)
-            self.next(KeepDecomposables = self.KeepBases)
-            self.test_for_completion()
-            if (self.completed) or ((max_deg!=-1) and (self.knownDeg>=max_deg)):
-                break
+        # With the option ``pipeline``, the next differentials are computed
+        # in a background process while the current degree is studied.
+        cdef int pipeline = coho_options['pipeline']
+        try:
+            while (1):
+                coho_logger.info('Start computation in Degree %d', self, self.knownDeg+1)
+                if pipeline > 0:
+                    bound = self.knownDeg+1+pipeline
+                    if self.suffDeg > -1:
+                        bound = min(bound, self.suffDeg+1)
+                    if max_deg > 0:
+                        bound = min(bound, max_deg+1)
+                    R.compute_ahead(bound)
+                self.next(KeepDecomposables = self.KeepBases)
+                self.test_for_completion()
+                if (self.completed) or ((max_deg!=-1) and (self.knownDeg>=max_deg)):
+                    break
+        finally:
+            if pipeline > 0:
+                R._join_worker(kill=True)
         # Catch the case of generalized quaternion groups:
         if self.completed and self.pRank==1:
             if not self.raw_filter_degree_type([X.name() for X in self.Gen if X.rdeg()]):
@@ -40,7 +40,7 @@ from __future__ import print_function, absolute_import
 
 from sage.all import SAGE_ROOT, DOT_SAGE, load
 from sage.all import Integer
-from pGroupCohomology.auxiliaries import coho_options, coho_logger, safe_save, _gap_reset_random_seed, gap, singular, Failure
+from pGroupCohomology.auxiliaries import coho_options, coho_logger, safe_save, _gap_reset_random_seed, gap, singular, Failure, workspace_lock
 from pGroupCohomology import barcode
 from pGroupCohomology.cohomology import COHO
 
@@ -359,33 +359,72 @@ class CohomologyRingFactory:
             sage: sorted(CohomologyRing.global_options().items())
             [('NrCandidates', 1000),
              ('SingularCutoff', 70),
+             ('action_cache', 0),
              ('autolift', 1),
              ('autoliftElAb', 0),
+             ('block_cache', 4),
+             ('buchberger_timing', False),
+             ('checkpoint', 0),
+             ('compress', False),
+             ('lazy_load', False),
+             ('lift_cache', 0),
+             ('lift_cache_policy', 'lru'),
+             ('pipeline', 0),
              ('reload', True),
              ('save', True),
+             ('slice_memory', 128),
              ('sparse', False),
+             ('sparse_files', False),
+             ('subgroup_workers', 1),
+             ('threads', 1),
              ('useMTX', True),
              ('use_web', True)]
             sage: CohomologyRing.global_options('sparse', 'nosave', autolift=4)
             sage: sorted(CohomologyRing.global_options().items())
             [('NrCandidates', 1000),
              ('SingularCutoff', 70),
+             ('action_cache', 0),
              ('autolift', 4),
              ('autoliftElAb', 0),
+             ('block_cache', 4),
+             ('buchberger_timing', False),
+             ('checkpoint', 0),
+             ('compress', False),
+             ('lazy_load', False),
+             ('lift_cache', 0),
+             ('lift_cache_policy', 'lru'),
+             ('pipeline', 0),
              ('reload', True),
              ('save', False),
+             ('slice_memory', 128),
              ('sparse', True),
+             ('sparse_files', False),
+             ('subgroup_workers', 1),
+             ('threads', 1),
              ('useMTX', True),
              ('use_web', True)]
             sage: CohomologyRing.reset()
             sage: sorted(CohomologyRing.global_options().items())
             [('NrCandidates', 1000),
              ('SingularCutoff', 70),
+             ('action_cache', 0),
              ('autolift', 1),
              ('autoliftElAb', 0),
+             ('block_cache', 4),
+             ('buchberger_timing', False),
+             ('checkpoint', 0),
+             ('compress', False),
+             ('lazy_load', False),
+             ('lift_cache', 0),
+             ('lift_cache_policy', 'lru'),
+             ('pipeline', 0),
              ('reload', True),
              ('save', True),
+             ('slice_memory', 128),
              ('sparse', False),
+             ('sparse_files', False),
+             ('subgroup_workers', 1),
+             ('threads', 1),
              ('useMTX', True),
              ('use_web', True)]
 
@@ -456,22 +495,48 @@ class CohomologyRingFactory:
             sage: sorted(CohomologyRing.global_options().items())
             [('NrCandidates', 1000),
              ('SingularCutoff', 70),
+             ('action_cache', 0),
              ('autolift', 1),
              ('autoliftElAb', 0),
+             ('block_cache', 4),
+             ('buchberger_timing', False),
+             ('checkpoint', 0),
+             ('compress', False),
+             ('lazy_load', False),
+             ('lift_cache', 0),
+             ('lift_cache_policy', 'lru'),
+             ('pipeline', 0),
              ('reload', True),
              ('save', True),
+             ('slice_memory', 128),
              ('sparse', False),
+             ('sparse_files', False),
+             ('subgroup_workers', 1),
+             ('threads', 1),
              ('useMTX', True),
              ('use_web', True)]
             sage: CohomologyRing.global_options('sparse', 'nosave', autolift=4)
             sage: sorted(CohomologyRing.global_options().items())
             [('NrCandidates', 1000),
              ('SingularCutoff', 70),
+             ('action_cache', 0),
              ('autolift', 4),
              ('autoliftElAb', 0),
+             ('block_cache', 4),
+             ('buchberger_timing', False),
+             ('checkpoint', 0),
+             ('compress', False),
+             ('lazy_load', False),
+             ('lift_cache', 0),
+             ('lift_cache_policy', 'lru'),
+             ('pipeline', 0),
              ('reload', True),
              ('save', False),
+             ('slice_memory', 128),
              ('sparse', True),
+             ('sparse_files', False),
+             ('subgroup_workers', 1),
+             ('threads', 1),
              ('useMTX', True),
              ('use_web', True)]
             sage: CohomologyRing.reset()
@@ -1777,7 +1842,13 @@ class CohomologyRingFactory:
             CacheKey = (KEY, os.path.join(root_workspace,GStem,'dat','State'))
             if q < 128:
                 extras['websource'] = False
-            OUT = self._check_compatibility(CacheKey, self._get_p_group_from_cache_or_db(GStem, KEY, **extras) or self._get_p_group_from_scratch(KEY, q, GStem, GroupName, **extras))
+            OUT = self._get_p_group_from_cache_or_db(GStem, KEY, **extras)
+            if OUT is None:
+                # Another process sharing the workspace may be about to
+                # create the ring. Once we have the lock, it will be there.
+                with workspace_lock(root_workspace, GStem):
+                    OUT = self._get_p_group_from_cache_or_db(GStem, KEY, **dict(extras, websource=False)) or self._get_p_group_from_scratch(KEY, q, GStem, GroupName, **extras)
+            OUT = self._check_compatibility(CacheKey, OUT)
             return OUT
 
         # For non prime power groups, we need a sufficiently large subgroup.
@@ -2036,6 +2107,154 @@ class CohomologyRingFactory:
             coho_logger.error("Unable to save basic ring setup", OUT, exc_info=1)
         return OUT
 
+    def compute_catalogue(self, keys, prime=None, processes=1, hosts=None, sage='sage'):
+        """
+        Compute and store the cohomology rings of a catalogue of groups.
+
+        INPUT:
+
+        - ``keys`` -- a list of group keys, as returned by
+          :meth:`create_group_key`. That is to say, addresses ``(q,n)``
+          in the SmallGroups library, or tuples ``(s,)``, where ``s`` is
+          a string that is evaluated in libGAP (and is used as the
+          name of the group).
+        - ``prime`` -- (optional prime) the coefficients for groups
+          whose order is not a prime power. It has to be provided if
+          there are such groups in the catalogue.
+        - ``processes`` -- (optional integer, default 1) number of local
+          worker processes.
+        - ``hosts`` -- (optional list of strings) names of hosts on which
+          workers are started via ``ssh``. A host name can be repeated, in
+          order to start several workers on that host. The workspace must
+          be available under the same name on all hosts.
+        - ``sage`` -- (optional string, default ``'sage'``) the command
+          that starts Sage in a worker, if ``hosts`` are provided.
+
+        OUTPUT:
+
+        A dictionary that associates to each given key, and to the key of
+        each added Sylow subgroup, ``True`` or a string describing the error.
+
+        ALGORITHM:
+
+        Equivalent keys (see :func:`_IsKeyEquivalent`) are only computed
+        once. A group given by a string ``s`` that is not equivalent to a
+        group in the SmallGroups library is computed with ``GroupName=s``,
+        so that it can afterwards be obtained by ``CohomologyRing(G, GroupName=s)``.
+        The Sylow subgroups of groups that are not of prime power
+        order are added to the catalogue, if their SmallGroups address
+        is available. First, all prime power groups are computed in the
+        order of their size, then all other groups.
+
+        Each worker takes the next group from a common queue as soon as it
+        is done with the previous group, so that the work is balanced. If
+        no ``hosts`` are given, the workers are forked from the present
+        process; otherwise, each worker is a new Sage session, either on
+        a given host or (as many as ``processes``) locally.
+
+        The workers protect the data of a group in the workspace by a
+        file lock (see :class:`~pGroupCohomology.auxiliaries.workspace_lock`),
+        which is also used when the ring of a subgroup is created.
+        Therefore, a subgroup ring that is needed by several workers is
+        computed only once, and different catalogue runs sharing the
+        same workspace do not interfere. Rings that are already completed
+        in the workspace are just loaded.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: D = CohomologyRing.compute_catalogue([(8,3), (8,4), ('SmallGroup(8,3)',), (12,3)], prime=2, processes=2)
+            sage: sorted(D.items(), key=repr)
+            [(('SmallGroup(8,3)',), True), ((12, 3), True), ((4, 2), True), ((8, 3), True), ((8, 4), True)]
+            sage: CohomologyRing(12,3,prime=2).completed
+            True
+
+        A group that is not equivalent to a group in the SmallGroups
+        library is stored under the name by which it was given::
+
+            sage: CohomologyRing.compute_catalogue([('DihedralGroup(8)',)])
+            {('DihedralGroup(8)',): True}
+            sage: CohomologyRing(libgap.eval('DihedralGroup(8)'), GroupName='DihedralGroup(8)').completed
+            True
+
+        The rings are in the workspace now, hence computing them
+        again is fast::
+
+            sage: CohomologyRing.compute_catalogue([(8,3), (8,4)])
+            {(8, 3): True, (8, 4): True}
+
+        """
+        # Deduplication and Sylow subgroups. The catalogue is formed by the
+        # keys that are computed, and equivalence is tested on the keys
+        # returned by create_group_key.
+        catalogue = []
+        normal_keys = []
+        def insert(key, normal_key):
+            for k, nk in zip(catalogue, normal_keys):
+                if _IsKeyEquivalent((nk,), (normal_key,)):
+                    return k
+            if len(normal_key)==2:
+                key = normal_key
+            catalogue.append(key)
+            normal_keys.append(normal_key)
+            return key
+        given = []
+        for key in keys:
+            key = tuple(key)
+            if len(key)==2:
+                given.append((key, insert(key, self.create_group_key(key))))
+            else:
+                given.append((key, insert(key, self.create_group_key([gap.eval(key[0])]))))
+        added = []
+        for key in list(catalogue):
+            G = gap.SmallGroup(key[0],key[1]) if len(key)==2 else gap.eval(key[0])
+            q = Integer(G.Order())
+            if q.is_prime_power():
+                continue
+            if prime is None:
+                raise ValueError("The parameter `prime` must be provided for the group %s"%repr(key))
+            S = G.SylowSubgroup(prime)
+            if S.Order() == 1:
+                continue
+            try:
+                SKey = self.create_group_key(S.IdGroup().sage())
+                size = len(catalogue)
+                insert(SKey, SKey)
+                if len(catalogue) > size:
+                    added.append(SKey)
+            except BaseException as msg:
+                if not ("group identification" in str(msg)):
+                    raise msg
+        def order(key):
+            return Integer(key[0]) if len(key)==2 else Integer(gap.eval(key[0]).Order())
+        phases = [sorted([k for k in catalogue if order(k).is_prime_power()], key=order),
+                  sorted([k for k in catalogue if not order(k).is_prime_power()], key=order)]
+        # Scheduling
+        OUT = {}
+        for L in phases:
+            if not L:
+                continue
+            coho_logger.info("Computing a catalogue of %d cohomology rings", None, len(L))
+            if hosts:
+                OUT.update(_run_catalogue_workers(L, prime, ['']*processes + list(hosts), sage))
+            elif processes > 1:
+                from sage.parallel.decorate import parallel
+                for (args, kwds), result in parallel(p_iter='fork', ncpus=min(processes, len(L)))(_compute_catalogue_entry)([(k, prime) for k in L]):
+                    OUT[args[0]] = result if result is True else str(result)
+            else:
+                for k in L:
+                    try:
+                        OUT[k] = _compute_catalogue_entry(k, prime)
+                    except BaseException as msg:
+                        if isinstance(msg, KeyboardInterrupt):
+                            raise
+                        OUT[k] = str(msg)
+        RESULT = dict([(k, OUT[k]) for k in added])
+        for key, k in given:
+            RESULT[key] = OUT[k]
+        return RESULT
+
     def set_workspace(self, s = None):
         """
         Define the location of the user's workspace.
@@ -2435,6 +2654,116 @@ def _IsKeyEquivalent(k1, k2):
         return min(similarity, _IsKeyEquivalent(k1[-1], k2[-1]))
     return similarity
 
+def _compute_catalogue_entry(key, prime=None):
+    """
+    Compute and store the cohomology ring of a group in a catalogue.
+
+    This is run by the workers of
+    :meth:`~pGroupCohomology.factory.CohomologyRingFactory.compute_catalogue`.
+
+    INPUT:
+
+    - ``key`` -- a group key
+    - ``prime`` -- (optional prime) the coefficients, if the group order
+      is not a prime power.
+
+    OUTPUT:
+
+    ``True``, after the completed ring is stored in the workspace.
+
+    TESTS::
+
+        sage: from pGroupCohomology import CohomologyRing
+        sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+        sage: from pGroupCohomology.factory import _compute_catalogue_entry
+        sage: _compute_catalogue_entry(('DihedralGroup(8)',))
+        True
+        sage: CohomologyRing(libgap.eval('DihedralGroup(8)'), GroupName='DihedralGroup(8)').completed
+        True
+
+    """
+    if len(key)==2:
+        args = (Integer(key[0]), Integer(key[1]))
+        kwds = {}
+    else:
+        args = (gap.eval(key[0]),)
+        kwds = {'GroupName': key[0]}
+    GStem = CohomologyRing.gstem(args, GroupName=kwds.get('GroupName'))
+    if not Integer(args[0] if len(key)==2 else args[0].Order()).is_prime_power():
+        kwds['prime'] = prime
+        GStem = '%smod%d'%(GStem, prime)
+    root = COHO.local_sources if CohomologyRing._create_local_sources else COHO.workspace
+    with workspace_lock(root, GStem):
+        H = CohomologyRing(*args, **kwds)
+        H.make()
+    return True
+
+def _run_catalogue_workers(keys, prime, hosts, sage):
+    """
+    Compute cohomology rings in new Sage sessions, on the given hosts.
+
+    INPUT:
+
+    - ``keys`` -- a list of group keys
+    - ``prime`` -- a prime or ``None``, see :func:`_compute_catalogue_entry`
+    - ``hosts`` -- a list of host names. For each item, a worker is
+      started. The empty string stands for the local host, which is
+      used without ``ssh``.
+    - ``sage`` -- a command that starts Sage
+
+    OUTPUT:
+
+    A dictionary associating to each key ``True``, or a string
+    that describes the error.
+
+    Each worker takes the next key from a common queue as soon
+    as it is done.
+
+    TESTS::
+
+        sage: from pGroupCohomology import CohomologyRing
+        sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+        sage: from pGroupCohomology.factory import _run_catalogue_workers
+        sage: D = _run_catalogue_workers([(8,3),(8,4)], None, ['',''], os.path.join(SAGE_ROOT, 'sage'))   # long time
+        sage: sorted(D.items())                                                                          # long time
+        [((8, 3), True), ((8, 4), True)]
+
+    """
+    import subprocess, threading
+    try:
+        from queue import Queue, Empty
+    except ImportError:
+        from Queue import Queue, Empty
+    Q = Queue()
+    for k in keys:
+        Q.put(k)
+    OUT = {}
+    root = COHO.local_sources if CohomologyRing._create_local_sources else COHO.workspace
+    def worker(host):
+        while True:
+            try:
+                k = Q.get_nowait()
+            except Empty:
+                return
+            code = "from pGroupCohomology import CohomologyRing; from pGroupCohomology.factory import _compute_catalogue_entry; CohomologyRing.set_workspace(%r); _compute_catalogue_entry(%r, %r)"%(root, tuple(k), prime)
+            cmd = [sage, '-c', code]
+            if host:
+                # the command is interpreted by the remote shell
+                cmd = ['ssh', host, ' '.join("'%s'"%c.replace("'", "'\\''") for c in cmd)]
+            coho_logger.info("Computing %r on %s", None, k, host or 'localhost')
+            P = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+            out = P.communicate()[0]
+            if P.returncode:
+                OUT[k] = out.decode('utf-8', 'replace').strip().split('\n')[-1]
+            else:
+                OUT[k] = True
+    T = [threading.Thread(target=worker, args=(h,)) for h in hosts]
+    for t in T:
+        t.start()
+    for t in T:
+        t.join()
+    return OUT
+
 CohomologyRing = CohomologyRingFactory()
 CohomologyRing.logger = coho_logger
 CohomologyRing.__doc__ = r"""
@@ -2549,6 +2878,21 @@ Each option is set by a string, and unset by prepending ``'no'`` to that string.
   * ``'sparse'`` [not default], remove temporarily unneeded data on
     the resolution from memory. With that option, the computation
     of very large examples becomes more feasible.
+  * ``'compress'`` [not default], store the differentials, Urbild
+    Gröbner bases and temporary files of a resolution compressed
+    in blocks of rows. That saves disk space and the time for
+    copying the data, at the expense of some computation time.
+  * ``'lazy_load'`` [not default], when loading a ring from a file,
+    read its resolution and its tables of monomials only when they
+    are needed. Read-only queries on stored rings become much faster.
+  * ``'buchberger_timing'`` [not default], include timings in the
+    statistics of the Buchberger algorithm, see
+    :meth:`~pGroupCohomology.resolution.RESL.buchberger_stats`. The counters
+    are always available.
+  * ``'sparse_files'`` [not default], store the differentials and Urbild
+    Gröbner bases of a resolution in a sparse format, listing only the
+    nonzero rows. Such files can only be read by
+    :func:`~pGroupCohomology.resolution.load_stored_matrix`.
 
   Further options have a numerical value:
 
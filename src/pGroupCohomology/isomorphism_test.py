@@ -161,7 +161,11 @@ class IsomorphismTest:
          (('potential isomorphism', 6), 169)]
 
     """
-    def __init__(self, D, C, use_annihilator = True, use_radical = False, cutoff = 15):
+    #: Minimal number of combined partial assignments per worker, for
+    #: which the test of a level of the search tree is distributed.
+    parallel_threshold = 64
+
+    def __init__(self, D, C, use_annihilator = True, use_radical = False, cutoff = 15, workers = 1):
         """
         INPUT:
 
@@ -169,6 +173,8 @@ class IsomorphismTest:
         - optional: Whether to use annihilators to detect non-isomorphy (default: True)
         - optional: Whether to use radicals to detect non-isomorphy (default: False)
         - optional: when to cut-off lists of candidates of partial isomorphisms (default: 15)
+        - optional: number of worker processes among which disjoint subtrees
+          of the search tree are distributed (default: 1)
 
         TESTS::
 
@@ -187,6 +193,12 @@ class IsomorphismTest:
         self.use_annihilator = use_annihilator
         self.use_radical = use_radical
         self.cutoff = cutoff
+        self.workers = workers
+        # Hilbert series of ideals in the codomain, their annihilators
+        # and radicals, keyed by the generators of the ideal. Unlike the
+        # candidates, they remain valid when backtracking.
+        self._hilbert_cache = {}
+        self._image_key = ()
         self.total_candidates = Integer(0)
         self.critical_generators = [] # a generator that can't be mapped
         self.rigid_generators = [] # all generators which have a unique
@@ -352,6 +364,25 @@ class IsomorphismTest:
              '1*a_3_3')
             sage: T = IsomorphismTest(H156, H158, cutoff = 1)
             sage: T.explore_isomorphisms()
+
+        Disjoint parts of the search tree can be tested in parallel. The
+        result is the same as in a serial test::
+
+            sage: T = IsomorphismTest(H156, H158, cutoff = 2, workers = 2)
+            sage: T.parallel_threshold = 0
+            sage: T.explore_isomorphisms()
+            ('1*a_1_1*a_3_2+1*c_4_4',
+             '1*c_4_5+1*c_4_4',
+             '1*a_1_0',
+             '1*a_1_1',
+             '1*a_1_2',
+             '1*a_3_2',
+             '1*a_3_3')
+            sage: T.statistic['worker processes'] > 0
+            True
+
+        ::
+
             sage: H85 = CohomologyRing(64, 85)
             sage: H173 = CohomologyRing(64, 173)
             sage: H85.make()
@@ -642,20 +673,28 @@ class IsomorphismTest:
                 coho_logger.info("No candidates remain", self)
             self._remove_partial_relations_from_cache(len(Gens))
             self._remove_candidates_from_cache(len(Gens))
-            if FirstHalf:
+            if FirstHalf and self.workers > 1 and len(FirstHalf) > 1 and \
+                    len(FirstHalf)*len(SecondHalf) >= self.parallel_threshold*self.workers:
+                if len(Gens)==len(self._domain.Gen):
+                    limit = 1
+                elif allow_cutoff:
+                    mapped = set(Gens).union([g[0] for g in self.rigid_generators])
+                    limit = self.cutoff*(2**(len(mapped)-len(self.rigid_generators)-1))
+                else:
+                    limit = None
+                C = self._parallel_candidates(FirstHalf, SecondHalf, Gens, Rigids, limit)
+                if len(Gens)==len(self._domain.Gen) and C:
+                    return C
+                if limit is not None and len(C) >= limit:
+                    C = C[:limit]
+                    coho_logger.debug("cutting list of candidates", self)
+                    for k in Gens:
+                        self.not_exhausted_generators.add(k)
+                    self.exhaustive = False
+            elif FirstHalf:
                 for Ims1,Ims2 in cartesian_product_iterator([FirstHalf, SecondHalf]):
-                    Ims = [None if (0!=a!=b!=0) else (a if a else b) for a,b in zip(Ims1,Ims2)]
-                    for g in self.rigid_generators:
-                        if 0!=Ims[g[0]-1]!=g[1]:
-                            raise RuntimeError("Value of rigid generator is not assumed")
-                        else:
-                            Ims[g[0]-1] = g[1]
-                            if g[0] not in Gens:
-                                Rigids.append(g[0])
-                    if None in Ims:
-                        continue
-                    if (0 in Ims and len(set(Ims))-1<len(Ims)-Ims.count(0)) or (0 not in Ims and len(set(Ims))<len(Ims)-Ims.count(0)):
-                        self.statistic['triviality'] = self.statistic.get('triviality',0) + 1
+                    Ims = self._combine_candidates(Ims1, Ims2, Gens, Rigids)
+                    if Ims is None:
                         continue
                     if self.potential_partial_isomorphism(Ims):
                         counter += 1
@@ -690,6 +729,137 @@ class IsomorphismTest:
         finally:
             pass
 
+    def _combine_candidates(self, Ims1, Ims2, Gens, Rigids):
+        """
+        Combine two partial assignments of generator images, together with the rigid generators.
+
+        OUTPUT:
+
+        The list of images, or ``None`` if the assignments are not compatible
+        or the resulting assignment is trivially not injective. Rigid generators
+        not in ``Gens`` are appended to the list ``Rigids``.
+
+        Used internally, not explicitly tested (but implicitly tested elsewhere).
+        """
+        Ims = [None if (0!=a!=b!=0) else (a if a else b) for a,b in zip(Ims1,Ims2)]
+        for g in self.rigid_generators:
+            if 0!=Ims[g[0]-1]!=g[1]:
+                raise RuntimeError("Value of rigid generator is not assumed")
+            else:
+                Ims[g[0]-1] = g[1]
+                if g[0] not in Gens:
+                    Rigids.append(g[0])
+        if None in Ims:
+            return None
+        if (0 in Ims and len(set(Ims))-1<len(Ims)-Ims.count(0)) or (0 not in Ims and len(set(Ims))<len(Ims)-Ims.count(0)):
+            self.statistic['triviality'] = self.statistic.get('triviality',0) + 1
+            return None
+        return Ims
+
+    def _subtree_candidates(self, FirstHalf, SecondHalf, Gens, limit):
+        """
+        Potential partial isomorphisms combined from two lists of partial assignments.
+
+        At most ``limit`` candidates are returned, unless ``limit`` is ``None``.
+
+        Used internally, not explicitly tested (but implicitly tested elsewhere).
+        """
+        C = []
+        Rigids = []
+        for Ims1,Ims2 in cartesian_product_iterator([FirstHalf, SecondHalf]):
+            Ims = self._combine_candidates(Ims1, Ims2, Gens, Rigids)
+            if Ims is None:
+                continue
+            if self.potential_partial_isomorphism(Ims):
+                C.append(tuple(Ims))
+                if limit is not None and len(C) >= limit:
+                    break
+        return C
+
+    def _parallel_candidates(self, FirstHalf, SecondHalf, Gens, Rigids, limit):
+        """
+        Distribute the test of combined partial assignments among worker processes.
+
+        ``FirstHalf`` is cut into contiguous blocks, each of which is combined
+        with ``SecondHalf``. The blocks are dealt out to forked worker processes
+        in turns, so that the work is balanced, while each worker reconstructs
+        the cohomology rings only once. The candidates are returned in the same
+        order as in a serial test, and the Hilbert series and statistics
+        obtained by the workers are merged into this instance, so that they
+        are available to later workers and after backtracking. An error
+        in a worker process is raised.
+
+        Used internally, not explicitly tested (but implicitly tested elsewhere).
+        """
+        from sage.parallel.decorate import parallel
+        for g in self.rigid_generators:
+            if g[0] not in Gens:
+                Rigids.append(g[0])
+        n = min(4*self.workers, len(FirstHalf))
+        step = (len(FirstHalf)+n-1)//n
+        blocks = [FirstHalf[i:i+step] for i in range(0, len(FirstHalf), step)]
+        coho_logger.info("Distributing %d x %d assignments for %r among %d workers", self, len(FirstHalf), len(SecondHalf), ["gen(%d)"%g for g in Gens], self.workers)
+        nproc = min(self.workers, len(blocks))
+        tasks = [[(i,B) for i,B in enumerate(blocks) if i%nproc==j] for j in range(nproc)]
+        results = {}
+        worker = parallel(p_iter='fork', ncpus=nproc)(_subtree_candidates_in_worker)
+        for (args, kwds), out in worker([(self, L, SecondHalf, Gens, limit) for L in tasks]):
+            if not isinstance(out, tuple):
+                raise RuntimeError("Worker process failed on blocks %s: %s"%([i for i,B in args[1]], out))
+            C, statistic, hilbert = out
+            results.update(C)
+            for k,v in statistic.items():
+                self.statistic[k] = self.statistic.get(k,0) + v
+            self._merge_hilbert_data(hilbert)
+        C = []
+        for i in range(len(blocks)):
+            if limit is not None and len(C) >= limit:
+                break
+            C.extend(results[i])
+        return C
+
+    def _worker_copy(self):
+        """
+        A copy of this test for a forked worker process, sharing the data of the search so far.
+
+        The cohomology rings are reconstructed in the new Singular interface of
+        the worker. Rigid and critical generators and all cached Hilbert series
+        are copied; the statistic of the copy starts from scratch.
+
+        Used internally, not explicitly tested (but implicitly tested elsewhere).
+        """
+        self._domain.reconstruct_singular()
+        if self._codomain is not self._domain:
+            self._codomain.reconstruct_singular()
+        W = IsomorphismTest(self._domain, self._codomain, use_annihilator=self.use_annihilator,
+                            use_radical=self.use_radical, cutoff=self.cutoff)
+        W.rigid_generators = list(self.rigid_generators)
+        W.critical_generators = list(self.critical_generators)
+        W._merge_hilbert_data(self._hilbert_data())
+        return W
+
+    def _hilbert_data(self):
+        """
+        The cached Hilbert series of image and preimage ideals, as a dictionary.
+
+        Used internally, not explicitly tested (but implicitly tested elsewhere).
+        """
+        return {'image': dict(self._hilbert_cache),
+                'preimage': dict(self.hilbert_of_preimage.cache),
+                'annihilator': dict(self.hilbert_of_preimage_annihilator.cache),
+                'radical': dict(self.hilbert_of_preimage_radical.cache)}
+
+    def _merge_hilbert_data(self, D):
+        """
+        Merge cached Hilbert series, as returned by :meth:`_hilbert_data`.
+
+        Used internally, not explicitly tested (but implicitly tested elsewhere).
+        """
+        self._hilbert_cache.update(D['image'])
+        self.hilbert_of_preimage.cache.update(D['preimage'])
+        self.hilbert_of_preimage_annihilator.cache.update(D['annihilator'])
+        self.hilbert_of_preimage_radical.cache.update(D['radical'])
+
     @lazy_attribute
     def unquotiented_domain(self):
         """
@@ -743,7 +913,8 @@ class IsomorphismTest:
     def _remove_candidates_from_cache(self, n):
         """
         Remove image candidates for all sets of less than or equal n and more
-        than 1 generators. This also removes cached Hilbert data.
+        than 1 generators. Cached Hilbert data are kept, since they only
+        depend on the generators resp. their images.
 
         Compare ._clear_candidates(), which removes everything that has been cut!
 
@@ -752,15 +923,6 @@ class IsomorphismTest:
         keys = [k for k in self.candidates_of_gens.cache.keys() if 1<len(k[0][0])<=n]
         for k in keys:
             del self.candidates_of_gens.cache[k]
-        keys = [k for k in self.hilbert_of_preimage.cache.keys() if len(k[0][0])<=n]
-        for k in keys:
-            del self.hilbert_of_preimage.cache[k]
-        keys = [k for k in self.hilbert_of_preimage_annihilator.cache.keys() if len(k[0][0])<=n]
-        for k in keys:
-            del self.hilbert_of_preimage_annihilator.cache[k]
-        keys = [k for k in self.hilbert_of_preimage_radical.cache.keys() if len(k[0][0])<=n]
-        for k in keys:
-            del self.hilbert_of_preimage_radical.cache[k]
 
     @cached_method
     def partial_relations(self,T):
@@ -837,6 +999,7 @@ class IsomorphismTest:
         if len(im_gens)!=len(self._domain.Gen):
             raise ValueError("%d generators, but %d images are given"%(len(self._domain.Gen),len(im_gens)))
         self._im_gens = im_gens
+        self._image_key = tuple(sorted(set(str(x) for x in im_gens if x)))
         self._SC.set_ring()
         if hasattr(self,'_Smap'):
             self.singular.eval('kill %s'%self._Smap.name())
@@ -886,7 +1049,21 @@ class IsomorphismTest:
             sage: X.hilbert_of_image()
             t^20 - 5*t^18 - 2*t^17 + 9*t^16 + 10*t^15 - 4*t^14 - 18*t^13 - 10*t^12 + 10*t^11 + 18*t^10 + 10*t^9 - 10*t^8 - 18*t^7 - 4*t^6 + 10*t^5 + 9*t^4 - 2*t^3 - 5*t^2 + 1
 
+        The Hilbert series is cached by the generators of the image ideal,
+        so that it is not recomputed when the same ideal occurs again while
+        backtracking::
+
+            sage: X.set_images((0,"2*b_2_3+1*b_2_1","2*b_2_1+1*b_2_0",0,0,0,0,0,0))
+            sage: ('ideal', X._image_key) in X._hilbert_cache
+            True
+            sage: X.hilbert_of_image() == X._hilbert_cache['ideal', X._image_key]
+            True
+
         """
+        try:
+            return self._hilbert_cache['ideal', self._image_key]
+        except KeyError:
+            pass
         self._SC.set_ring()
         #--tmpI = self._Smap.ideal().std()
         self.singular.eval('%smapI = std(ideal(%s))'%(self.prefix,self._Smap.name()))
@@ -895,7 +1072,9 @@ class IsomorphismTest:
         #--tmpI2 = self.singular('fetch(%s,%s)+qrels'%(self._SC.name(),tmpI.name()))
         self.singular.eval('%sfetchI = fetch(%s,%smapI)+qrels'%(self.prefix,self._SC.name(),self.prefix))
         self.singular.eval('attrib(%sfetchI,"isSB",1)'%self.prefix)
-        return first_hilbert_series(self.singular('%sfetchI'%(self.prefix)), self._codomain.degvec)
+        H = first_hilbert_series(self.singular('%sfetchI'%(self.prefix)), self._codomain.degvec)
+        self._hilbert_cache['ideal', self._image_key] = H
+        return H
 
     @lazy_attribute
     def hilbert_of_image_annihilator(self):
@@ -917,6 +1096,10 @@ class IsomorphismTest:
             -t^20 + 3*t^18 + 2*t^17 - t^16 - 6*t^15 - 6*t^14 + 2*t^13 + 8*t^12 + 10*t^11 - 10*t^9 - 8*t^8 - 2*t^7 + 6*t^6 + 6*t^5 + t^4 - 2*t^3 - 3*t^2 + 1
 
         """
+        try:
+            return self._hilbert_cache['annihilator', self._image_key]
+        except KeyError:
+            pass
         self._SC.set_ring()
         #--tmpI = self._Smap.ideal().std()
         ActiveGens = [i for i,x in enumerate(self._im_gens) if x]
@@ -934,7 +1117,9 @@ class IsomorphismTest:
         # qrels contains *all* quotient relations, including the nontrivials.
         self.singular.eval('%sfetchI = fetch(%s,%smapI)+qrels'%(self.prefix,self._SC.name(),self.prefix))
         self.singular.eval('attrib(%sfetchI,"isSB",1)'%self.prefix)
-        return first_hilbert_series(self.singular('%sfetchI'%(self.prefix)), self._codomain.degvec)
+        H = first_hilbert_series(self.singular('%sfetchI'%(self.prefix)), self._codomain.degvec)
+        self._hilbert_cache['annihilator', self._image_key] = H
+        return H
 
     @lazy_attribute
     def hilbert_of_image_radical(self):
@@ -956,6 +1141,10 @@ class IsomorphismTest:
             t^16 - 2*t^15 - 3*t^14 + 6*t^13 + 6*t^12 - 6*t^11 - 13*t^10 + 2*t^9 + 18*t^8 + 2*t^7 - 13*t^6 - 6*t^5 + 6*t^4 + 6*t^3 - 3*t^2 - 2*t + 1
 
         """
+        try:
+            return self._hilbert_cache['radical', self._image_key]
+        except KeyError:
+            pass
         #~ self._SC.set_ring()
         #--tmpI = self._Smap.ideal().std()
         #~ self.singular.eval('%smapI = std(ideal(%s))'%(self.prefix,self._Smap.name()))
@@ -965,7 +1154,9 @@ class IsomorphismTest:
         self.singular.eval('%sfetchI = std(radical(ideal(imap(%s,%s))+qrels))'%(self.prefix, self._SC.name(), self._Smap.name()))
         #~ self.singular.eval('%sfetchI = fetch(%s,%smapI)+qrels'%(self.prefix,self._SC.name(),self.prefix))
         #~ self.singular.eval('attrib(%sfetchI,"isSB",1)'%self.prefix)
-        return first_hilbert_series(self.singular('%sfetchI'%(self.prefix)), self._codomain.degvec)
+        H = first_hilbert_series(self.singular('%sfetchI'%(self.prefix)), self._codomain.degvec)
+        self._hilbert_cache['radical', self._image_key] = H
+        return H
 
     @cached_method
     def hilbert_of_preimage(self, Gens):
@@ -1294,3 +1485,24 @@ class IsomorphismTest:
                 self.statistic["not surjective"] = self.statistic.get("not surjective",0) + 1
                 return False
         return True
+
+def _subtree_candidates_in_worker(T, blocks, SecondHalf, Gens, limit):
+    """
+    Test the combined partial assignments of some blocks in a forked worker process.
+
+    INPUT:
+
+    ``blocks`` is a list of pairs formed by a block number and a block of
+    the first half of the partial assignments.
+
+    OUTPUT:
+
+    A dictionary associating the candidates to the block numbers, the
+    statistic and the Hilbert data of the worker.
+
+    Used internally, not explicitly tested (but implicitly tested elsewhere).
+    """
+    W = T._worker_copy()
+    W.statistic['worker processes'] = 1
+    C = dict([(i, W._subtree_candidates(B, SecondHalf, Gens, limit)) for i,B in blocks])
+    return C, W.statistic, W._hilbert_data()
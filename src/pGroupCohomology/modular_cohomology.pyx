@@ -230,6 +230,56 @@ def _IdGroup(G, D, Client, ring=True):
             D[q][n] = CohomologyRing(G,GStem=Client.GStem+'_%d_%d'%(q,-n), prime=D['prime'],useFactorization=Client.useFactorization,useElimination=Client.useElimination)
     return (q,n,G)
 
+def _difference_row(Pieces, tmpD):
+    """
+    Coefficient list of a polynomial given in pieces of strings.
+
+    INPUT:
+
+    - ``Pieces``, a list of strings whose concatenation by ``+`` is a
+      linear combination of standard monomials of a cohomology ring
+    - ``tmpD``, a dictionary associating the standard monomials (strings)
+      with their position
+
+    OUTPUT:
+
+    The list of coefficients of the polynomial, ordered by ``tmpD``.
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology.modular_cohomology import _difference_row
+        sage: _difference_row(['b_1_0^2-c_2_1', '2*a_1_0*b_1_0'], {'b_1_0^2':0, 'a_1_0*b_1_0':1, 'c_2_1':2})
+        [1, 2, -1]
+        sage: _difference_row(['0'], {'b_1_0^2':0})
+        [0]
+
+    """
+    cdef list L = len(tmpD)*[0]
+    cdef list Terms, NegTerms
+    for p in Pieces:
+        NegTerms = p.split('-')
+        Terms = NegTerms.pop(0).split('+')
+        if Terms == ['']:
+            Terms = []
+        while NegTerms:
+            Terms.extend( ('-' + NegTerms.pop(0)).split('+'))
+        if Terms!=['0']:
+            for tm in Terms:
+                if (tm[0]=='-'):
+                    if tm[1].isdigit():
+                        cf,mn = tm.split('*',1)
+                    else:
+                        cf = -1
+                        mn = tm[1:]
+                else:
+                    if tm[0].isdigit():
+                        cf,mn = tm.split('*',1)
+                    else:
+                        cf = 1
+                        mn = tm
+                L[tmpD[mn]] = int(cf)
+    return L
+
 ###################################################
 ##                                               ##
 ##   Modular Cohomology Rings of finite groups   ##
@@ -1054,6 +1104,8 @@ class MODCOHO(COHO):
         self.setprop('Cosets',[X for X in self.Cosets if X is not None])
         self._PtoPcapCPdirectSing = [singular(f) for f in self._PtoPcapCPdirect]
         self._PtoPcapCPtwistSing = [singular(f) for f in self._PtoPcapCPtwist]
+        # the cached difference rows are indexed by the maps
+        self._stable_cache()['diffs'].clear()
         if len(self._PtoPcapCPdirect)<l:
             l = len(self._PtoPcapCPdirect)
             if l==1:
@@ -1576,6 +1628,109 @@ class MODCOHO(COHO):
 ##         Pivots.reverse()
 ##         return OUT, Monomials, Pivots
 
+    def _stable_cache(self):
+        """
+        Data cached by :meth:`stable_space`, in the current session.
+
+        OUTPUT:
+
+        A dictionary with two items:
+
+        - ``'diffs'``: a dictionary which associates a pair ``(n,i)``
+          with a dictionary, associating degree-``n`` standard monomials
+          of the underlying subgroup with the coefficient list of the
+          difference of their images under the ``i``-th direct and twisted
+          map.
+        - ``'bases'``: a dictionary which associates a degree with the
+          basis of the stable subspace returned by :meth:`stable_space`.
+
+        TESTS::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(48,50, prime=2)
+            sage: g,M,MS = H.stable_space(2)
+            sage: H._stable_cache()['bases'][2] is g
+            True
+            sage: sorted(H._stable_cache()['diffs'].keys())
+            [(2, 0), (2, 1)]
+            sage: H.stable_space(2)[2] == MS
+            True
+
+        """
+        try:
+            return self.__dict__['_stable_data']
+        except KeyError:
+            D = self.__dict__['_stable_data'] = {'diffs':{}, 'bases':{}}
+            return D
+
+    def _known_stable_products(self, int n):
+        """
+        Interreduced products of stable elements that were found in lower degrees.
+
+        Products of stable elements are stable. So, any stable element
+        of degree ``n`` can be reduced by these products, so that it does
+        not involve their leading monomials, which are thus excluded
+        from the linear algebra in :meth:`stable_space`.
+
+        INPUT:
+
+        ``n``, the degree (integer)
+
+        OUTPUT:
+
+        The list of leading monomials (strings) of the interreduced
+        products of stable elements from :meth:`stable_space` whose
+        degrees add up to ``n``. The products are stored in the ideal
+        ``<prefix>StU`` of the quotient ring of the underlying subgroup.
+
+        TESTS::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: G = libgap.MathieuGroup(11)
+            sage: H = CohomologyRing(G,prime=2,GroupName='M11', from_scratch=True)
+            sage: H._known_stable_products(8)
+            []
+            sage: g,M,MS = H.stable_space(4)
+            sage: all(t in H._HP.standard_monomials(8) for t in H._known_stable_products(8))
+            True
+
+        """
+        singular = self.GenS.parent()
+        cdef dict Bases = self._stable_cache()['bases']
+        cdef list Prods = []
+        cdef int d
+        try:
+            for d in range(1, n//2+1):
+                for a in Bases.get(d) or []:
+                    for b in Bases.get(n-d) or []:
+                        a.value()._check_valid()
+                        b.value()._check_valid()
+                        Prods.append('%s*%s'%(a.value().name(), b.value().name()))
+        except (ValueError, TypeError):
+            # The Singular session was restarted
+            Bases.clear()
+            Prods = []
+        singular(self._HP).set_ring()
+        if singular.eval('defined(%sStU)'%self.prefix)=='0':
+            singular.eval('ideal %sStU'%self.prefix)
+        else:
+            singular.eval('%sStU=ideal(0)'%self.prefix)
+        if not Prods:
+            return []
+        singular.eval('%sStU=simplify(NF(ideal(%s),std(0)),2)'%(self.prefix, ','.join(Prods)))
+        # interreduction does not work in quotient rings
+        self._HP.set_ring()
+        tmpBR = singular('basering')
+        tmpI = singular('imap(%s,%sStU)'%(singular(self._HP).name(),self.prefix))
+        singular.eval('%s=interred(NF(%s,%sI))'%(tmpI.name(),tmpI.name(),self._HP.prefix))
+        singular(self._HP).set_ring()
+        singular.eval('%sStU=simplify(imap(%s,%s),2)'%(self.prefix,tmpBR.name(),tmpI.name()))
+        if singular.eval('size(%sStU)'%self.prefix)=='0':
+            return []
+        return [t.strip() for t in singular.eval('print(normalize(lead(%sStU)))'%self.prefix).split(',')]
+
     def stable_space(self, int n):
         """
         return a basis for the subspace of stable cocycles of the underlying subgroup in a given degree.
@@ -1657,6 +1812,14 @@ class MODCOHO(COHO):
         # shipping the monomials to the quotient ring, so that we can map it
         if m==0:
             return [],[],[]
+        # Stable elements that are reduced with respect to products of
+        # known stable elements don't involve their leading monomials.
+        KnownLeads = self._known_stable_products(n)
+        cdef int u = len(KnownLeads)
+        cdef set LeadSet = set(KnownLeads)
+        cdef list Free = [k for k in range(m) if Monomials[k] not in LeadSet]
+        if u:
+            coho_logger.debug( '> %d monomials are leading monomials of products of stable elements', self, u)
         singular(self._HP).set_ring()
         if m>1:
             singular.eval('poly %sP(1..%d) = imap(%s,%sMon)'%(self.prefix, m, RHP.name(), self.prefix))
@@ -1664,17 +1827,25 @@ class MODCOHO(COHO):
             singular.eval('poly %sP(1) = imap(%s,%sMon)[1]'%(self.prefix, RHP.name(), self.prefix))
         singular.eval('ideal %sMon=imap(%s,%sMon)'%(self.prefix, RHP.name(), self.prefix))
         coho_logger.debug( '> found %d monomials for the subgroup', self,m)
-        cdef list L, Restr, Mon, Coefs, Differences, Terms, NegTerms, tmpL1, tmpL2
+        cdef list L, Restr, Coefs, tmpL1
         cdef dict SubgpMonomials = {} # will be a dictionary COHO._key -> monomial dictionary
+        cdef dict Diffs
 
-        # Go through all monomials of self._HP, apply the direct and twisted induced maps, express
-        # their difference as a polynomial, and read off a list from it.
-        # 1. get strings from the differences that have been computed above
-        Differences = []
+        # Go through the monomials of self._HP that are not leading monomials
+        # of known stable products, apply the direct and twisted induced maps,
+        # express their difference as a polynomial, and read off a list from it.
+        # These lists are cached.
+        Restr = [[] for k in Free]
         SubgpMonomials[self._HP._key] = dict(zip(Monomials, [j for j in range(len(Monomials))]))
         for i from 0 <= i < l:
             f = self._PtoPcapCPdirect[i]
             fd = self._PtoPcapCPtwist[i]
+            Diffs = self._stable_cache()['diffs'].setdefault((n,i), {})
+            if all(Monomials[k] in Diffs for k in Free):
+                coho_logger.debug( "> Using cached differences for conjugator isomorphism %d"%i, self)
+                for j from 0 <= j < len(Free):
+                    Restr[j].extend(Diffs[Monomials[Free[j]]])
+                continue
             if not f.codomain()._key in SubgpMonomials:
                 f.codomain()._makeStdMon(n,"%sMon"%f.codomain().prefix)
                 f.codomain().set_ring()
@@ -1686,18 +1857,19 @@ class MODCOHO(COHO):
             # The following is working around a memory leak in Singular
             # and a bug in the Singular interface
             tmpP = singular.poly(0)
-            tmpL2 = []
-            for k from 1<=k<=m:
-                tmpL1=[]
-                singular.eval('%s=NF(%s(%sP(%d))-%s(%sP(%d)),std(0))'%(tmpP.name(),self._PtoPcapCPdirectSing[i].name(),self.prefix,k, self._PtoPcapCPtwistSing[i].name(),self.prefix,k))
-                a = int(singular.eval('size(%s)'%tmpP.name()))
-                nr = int(a/SizePieces)
-                for j from 0<=j<nr:
-                    tmpL1.append(singular.eval('print(%s[%d..%d])'%(tmpP.name(),j*SizePieces+1,(j+1)*SizePieces)).strip())
-                if nr*SizePieces<a:
-                    tmpL1.append(singular.eval('print(%s[%d..%d])'%(tmpP.name(),nr*SizePieces+1,a)).strip())
-                tmpL2.append(tmpL1)
-            Differences.append(tmpL2)
+            for j from 0 <= j < len(Free):
+                k = Free[j]
+                if Monomials[k] not in Diffs:
+                    tmpL1=[]
+                    singular.eval('%s=NF(%s(%sP(%d))-%s(%sP(%d)),std(0))'%(tmpP.name(),self._PtoPcapCPdirectSing[i].name(),self.prefix,k+1, self._PtoPcapCPtwistSing[i].name(),self.prefix,k+1))
+                    a = int(singular.eval('size(%s)'%tmpP.name()))
+                    nr = int(a/SizePieces)
+                    for b from 0<=b<nr:
+                        tmpL1.append(singular.eval('print(%s[%d..%d])'%(tmpP.name(),b*SizePieces+1,(b+1)*SizePieces)).strip())
+                    if nr*SizePieces<a:
+                        tmpL1.append(singular.eval('print(%s[%d..%d])'%(tmpP.name(),nr*SizePieces+1,a)).strip())
+                    Diffs[Monomials[k]] = _difference_row(tmpL1, SubgpMonomials[f.codomain()._key])
+                Restr[j].extend(Diffs[Monomials[k]])
 
 
         for f in self._PtoPcapCPdirect:
@@ -1707,56 +1879,22 @@ class MODCOHO(COHO):
                     singular.eval('kill %sMon'%f.codomain().prefix)
 
         singular(self._HP).set_ring()
-        coho_logger.info( "Setting up conditions to determine stable elements", self)
-        Restr = []
-        for j from 0 <= j < m:
-            Restr.append([])
-            for i from 0 <= i < l:
-                f = self._PtoPcapCPdirect[i]
-                tmpD = SubgpMonomials[f.codomain()._key]
-                L = len(tmpD.keys())*[0]
-                Coefs = []
-                Mon = []
-                tmpL1 = Differences[i][j]
-                for p in tmpL1:
-                    NegTerms = p.split('-')
-                    Terms = NegTerms.pop(0).split('+')
-                    if Terms == ['']:
-                        Terms = []
-                    while NegTerms:
-                        Terms.extend( ('-' + NegTerms.pop(0)).split('+'))
-                    if Terms!=['0']:
-                        while Terms:
-                            tm = Terms.pop(0)
-                            if (tm[0]=='-'):
-                                if tm[1].isdigit():
-                                    cf,mn = tm.split('*',1)
-                                else:
-                                    cf = -1
-                                    mn = tm[1:]
-                            else:
-                                if tm[0].isdigit():
-                                    cf,mn = tm.split('*',1)
-                                else:
-                                    cf = 1
-                                    mn = tm
-                            Coefs.append(int(cf))
-                            Mon.append(mn)
-                k = len(Mon)
-                for nr from 0 <= nr < k:
-                    try:
-                        L[tmpD[Mon[nr]]] = Coefs[nr]
-                    except:
-                        raise
-                Restr[-1].extend(L)
         coho_logger.info( "Solving equations", self)
-        if Restr and Restr[0]:
-            M = new_mtx(MatNullSpace__(rawMatrix(self._prime, Restr)), None)
-        else:
-            M = new_mtx(MatId(self._prime, len(Monomials)), None)
-        if M.nrows():
-            L = [M._rowlist_(i) for i in range(M.nrows())]
-        else:
+        # The solutions are in the coordinates given by Free
+        L = []
+        if Free:
+            if Restr[0]:
+                M = new_mtx(MatNullSpace__(rawMatrix(self._prime, Restr)), None)
+            else:
+                M = new_mtx(MatId(self._prime, len(Free)), None)
+            for i in range(M.nrows()):
+                tmpL1 = M._rowlist_(i)
+                Coefs = m*[0]
+                for j from 0 <= j < len(Free):
+                    Coefs[Free[j]] = tmpL1[j]
+                L.append(Coefs)
+        if not (L or u):
+            self._stable_cache()['bases'][n] = []
             return [],[],[]
         # Create MODCOCH instances, which avoids lifting of cocycles and
         # and computation of higher terms of the resolution of self._HP
@@ -1769,13 +1907,17 @@ class MODCOHO(COHO):
         cdef list OUT = []
         from pGroupCohomology.cochain import MODCOCH
         l = len(L)
-        singular.eval('%stmpI[%d]=0'%(self.prefix,l))
+        if u:
+            singular.eval('%stmpI=%sStU'%(self.prefix,self.prefix))
+        if l:
+            singular.eval('%stmpI[%d]=0'%(self.prefix,u+l))
         for j from 0 < j <= l:
             Coefs = L[j-1]
             for i from 0 <= i < m:
                 if Coefs[i]!=0:
-                    singular.eval('%stmpI[%d]=%d*%sP(%d)+%stmpI[%d]'%(self.prefix, j, Coefs[i], self.prefix, i+1, self.prefix, j))
+                    singular.eval('%stmpI[%d]=%d*%sP(%d)+%stmpI[%d]'%(self.prefix, u+j, Coefs[i], self.prefix, i+1, self.prefix, u+j))
         singular.eval('kill %sP(1..%d)'%(self.prefix,m))
+        singular.eval('kill %sStU'%self.prefix)
 
         singular.eval('%stmpI=sort(%stmpI)[1]'%(self.prefix,self.prefix))
         # interreduction does not work in quotient rings. Hence, we must go through the "proper" basering of self_HP
@@ -1793,6 +1935,7 @@ class MODCOHO(COHO):
         Pivots.reverse()
         singular.eval('kill %stmpI'%self.prefix)
         Monomials.reverse()
+        self._stable_cache()['bases'][n] = OUT
         return OUT, Monomials, Pivots
 
 
@@ -4139,6 +4282,7 @@ fi
                 self.StdMon[n][X.name()]=singular.ideal(X.name())
         if self.lastRelevantDeg>0:
             singular.eval('ideal %sI = imap(%sr(%d),%sI)'%(self.prefix,self.prefix,self.lastRelevantDeg,self.prefix))
+            self._transfer_groebner_basis(self.lastRelevantDeg, n)
             # keep track of decomposable generators --
             # We need them for lifting the Dickson invariants!
             singular.eval('ideal %sDG = imap(%sr(%d),%sDG)'%(self.prefix,self.prefix,self.lastRelevantDeg,self.prefix))
@@ -4382,15 +4526,30 @@ fi
             coho_logger.info("We have the degree bound %d"%(self.suffDeg), self)
         if max_deg>0 and max_deg<self.suffDeg:
             coho_logger.info("We will compute at most out to degree %d"%(max_deg), self)
-        while (1):
-            self.next()
-            if (self.suffDeg!=-1) and (self.knownDeg >= self.suffDeg):
-                coho_logger.info("Computation went beyond a previously obtained degree bound",self)
-                self.completed = True
-            else:
-                self.test_for_completion()
-            if (self.completed) or ((max_deg!=-1) and (self.knownDeg>=max_deg)):
-                break
+        # With the option ``pipeline``, the next differentials of the
+        # resolution of the Sylow subgroup are computed in a background
+        # process while the current degree is studied.
+        cdef int pipeline = coho_options['pipeline']
+        try:
+            while (1):
+                if pipeline > 0:
+                    bound = self.knownDeg+1+pipeline
+                    if self.suffDeg > -1:
+                        bound = min(bound, self.suffDeg+1)
+                    if max_deg > 0:
+                        bound = min(bound, max_deg+1)
+                    R.compute_ahead(bound)
+                self.next()
+                if (self.suffDeg!=-1) and (self.knownDeg >= self.suffDeg):
+                    coho_logger.info("Computation went beyond a previously obtained degree bound",self)
+                    self.completed = True
+                else:
+                    self.test_for_completion()
+                if (self.completed) or ((max_deg!=-1) and (self.knownDeg>=max_deg)):
+                    break
+        finally:
+            if pipeline > 0:
+                R._join_worker(kill=True)
         self.set_ring()
         self.GenS = singular('basering')
         if self.completed:
@@ -38,6 +38,15 @@ cdef class G_ALG:
 cdef class LIFTcontainer:
     cdef RESL Parent
     cdef dict Data
+    cdef long limit     # bytes of lifts kept in memory, 0 if unbounded
+    cdef object policy  # 'lru' or 'degree'
+    cdef dict Use       # time of the last access to the lifts (n,d)
+    cdef dict Size      # bytes of the lifts (n,d) in memory
+    cdef dict Files     # file from which the lifts (n,d) were loaded
+    cdef set Dirty      # lifts (n,d) that changed since they were loaded or stored
+    cdef long clock, nbytes, hits, misses, evictions
+    cdef touch(self, tuple X, long delta)
+    cdef evict(self, tuple keep)
 
 cdef class RESL:
     cdef __weakref__
@@ -46,6 +55,7 @@ cdef class RESL:
     cdef G_ALG G_Alg
     cdef LIFTcontainer Lifts
     cdef dict Autolift
+    cdef dict BuchStats # statistics of the Buchberger algorithm per degree
     cdef list Action
     cdef int _Action_saved
     cdef nRgs_t *nRgs  # points to Urbild Groebner basis
@@ -54,4 +64,5 @@ cdef class RESL:
     cdef object rstem  # resolution name
     cdef object gps_folder # folder for group data...
     cdef object res_folder # ... and resolution data
+    cdef object _worker    # (pid, degree, new degrees) of a process started by compute_ahead
     cpdef tuple CochainToChainmap(self, long n, MTX Coc)
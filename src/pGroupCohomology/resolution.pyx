@@ -51,12 +51,12 @@ from sage.all import deepcopy
 from sage.all import load
 from sage.env import DOT_SAGE, SAGE_ROOT, SAGE_LOCAL
 
-from pGroupCohomology.auxiliaries import gap, singular, coho_options, _gap_reset_random_seed, coho_logger, safe_save
+from pGroupCohomology.auxiliaries import gap, singular, coho_options, _gap_reset_random_seed, coho_logger, safe_save, workspace_lock
 from pGroupCohomology.cochain cimport YCOCH
 from pGroupCohomology.cochain cimport COCH
 
 from libc.string cimport memcpy
-from cysignals.memory cimport sig_free
+from cysignals.memory cimport sig_free, check_allocarray
 from cysignals.signals cimport sig_check, sig_on, sig_off
 from sage.cpython.string cimport str_to_bytes, bytes_to_str
 from sage.cpython.string import FS_ENCODING
@@ -100,10 +100,145 @@ def baseMTX(f, m,n, i,j):
     M.set_immutable()
     return M
 
+def load_stored_matrix(filename):
+    """
+    Return an immutable matrix that was stored on disk by a resolution.
+
+    INPUT:
+
+    ``filename`` -- the name of a file in MeatAxe format, or in the
+    sparse or compressed format that is used for the differentials and
+    Urbild Groebner bases if the option ``'sparse_files'`` or ``'compress'``
+    is set.
+
+    NOTE:
+
+    Files in the sparse or compressed format can not be read by
+    ``MTX.from_filename``. These formats only save disk space; the
+    returned matrix is dense.
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology.resolution import load_stored_matrix, makeGroupData, RESL
+        sage: from pGroupCohomology import CohomologyRing
+        sage: tmp_root = tmp_dir()
+        sage: makeGroupData(8,3,folder=tmp_root)
+        sage: gstem='8gp3'
+        sage: gps_folder=os.path.join(tmp_root,gstem)
+        sage: res_folder1 = os.path.join(gps_folder,'dat')
+        sage: R = RESL(gstem,gps_folder,res_folder1)
+        sage: CohomologyRing.global_options('sparse_files')
+        sage: for i in range(3):
+        ....:     R.nextDiff()
+        sage: CohomologyRing.global_options('nosparse_files')
+        sage: sparse = os.path.join(res_folder1, 'Res'+gstem+'d03.bin')
+        sage: load_stored_matrix(sparse) == R[3]
+        True
+
+    In the sparse format, only the nonzero rows are stored::
+
+        sage: res_folder = tmp_dir()
+        sage: R2 = RESL(gstem,gps_folder,res_folder)
+        sage: for i in range(3):
+        ....:     R2.nextDiff()
+        sage: dense = os.path.join(res_folder, 'Res'+gstem+'d03.bin')
+        sage: os.path.getsize(sparse) < os.path.getsize(dense)
+        True
+        sage: load_stored_matrix(dense) == R[3]
+        True
+
+    In the compressed format, the rows are compressed in blocks, which
+    also applies to the temporary files of the Buchberger algorithm. The
+    compressed files are reloaded as any other::
+
+        sage: CohomologyRing.global_options('compress', slice_memory=0)
+        sage: res_folder3 = tmp_dir()
+        sage: R3 = RESL(gstem,gps_folder,res_folder3)
+        sage: for i in range(3):
+        ....:     R3.nextDiff()
+        sage: compressed = os.path.join(res_folder3, 'Res'+gstem+'d03.bin')
+        sage: load_stored_matrix(compressed) == R[3]
+        True
+        sage: R4 = RESL(gstem,gps_folder,res_folder3)
+        sage: for i in range(4):
+        ....:     R4.nextDiff()
+        sage: R4.rank(4)
+        5
+        sage: CohomologyRing.reset()
+
+    """
+    cdef Matrix_t *mat
+    fn = str_to_bytes(filename, FS_ENCODING, 'surrogateescape')
+    sig_on()
+    try:
+        mat = mappedMatLoad(fn)
+    finally:
+        sig_off()
+    cdef MTX M = new_mtx(mat, None)
+    M.set_immutable()
+    return M
+
 ####################
 ## Group data related auxiliary functions
 
-def makeGroupData(q,n, folder, ElAb=False, Forced=False):
+cdef int build_group_files(stem, long p, list perms) except 1:
+    """
+    Construct the basic data files of a group algebra without external programs.
+
+    INPUT:
+
+    - ``stem`` -- string, path and stem of the files to be created
+    - ``p`` -- prime, the characteristic
+    - ``perms`` -- list of lists of integers. The `a`-th list is the list of
+      images of the points ``1,...,N`` under the `a`-th generator of the
+      regular permutation action of the group, as provided by the Gap
+      function ``regularPermutationImages``.
+
+    The nontips are constructed with respect to the reverse length-lex
+    ordering, both action matrices are computed for all generators using
+    ``coho_options['threads']`` threads, and the files ``.nontips``,
+    ``.gens``, ``.lgens``, ``.bch`` as well as the snapshot are written.
+    The ``.reg`` file that is read by ``makeNontips`` is not created.
+
+    This is used by :func:`makeGroupData`, where it is tested.
+    """
+    cdef long N = len(perms[0])
+    cdef long arrows = len(perms)
+    cdef long a, j, x
+    cdef long *perm
+    cdef group_t *G = namedGroupRecord(str_to_bytes(stem, FS_ENCODING, 'surrogateescape'))
+    try:
+        G.p = p
+        G.ordering = c'R'
+        G.arrows = arrows
+        G.nontips = N
+        perm = <long*>check_allocarray(arrows*N, sizeof(long))
+        try:
+            for a in range(arrows):
+                if len(perms[a]) != N:
+                    raise ValueError("All permutations must be of degree %d"%N)
+                for j in range(N):
+                    x = perms[a][j]
+                    if x < 1 or x > N:
+                        raise ValueError("Point %d is out of range"%x)
+                    perm[a*N+j] = x
+            sig_on()
+            try:
+                buildGroupRecord(G, perm, coho_options['threads'])
+                saveNonTips(G)
+                saveActionMatrices(G)
+                saveLeftActionMatrices(G)
+                saveBasisChangeMatrices(G)
+                saveGroupSnapshot(G)
+            finally:
+                sig_off()
+        finally:
+            sig_free(perm)
+    finally:
+        freeGroupRecord(G)
+    return 0
+
+def makeGroupData(q,n, folder, ElAb=False, Forced=False, in_process=False):
     r"""
     Create basic data files the cohomology computation of ``SmallGroup(q,n)``.
 
@@ -117,6 +252,10 @@ def makeGroupData(q,n, folder, ElAb=False, Forced=False):
       group is elementary abelian.
     - ``Forced`` (optional bool, default False) -- if True, force
       recomputation.
+    - ``in_process`` (optional bool, default False) -- if True, the basis
+      of the group algebra and the action matrices are computed in the
+      current process, rather than by the external programs that are
+      called from Gap.
 
     OUTPUT:
 
@@ -202,6 +341,19 @@ def makeGroupData(q,n, folder, ElAb=False, Forced=False):
         [0 1 0 0 0 0 0 0]
         [0 0 0 0 0 1 0 1]
 
+    When the data are computed in process, no intermediate files are
+    written and the external programs are not called. The result is
+    the same::
+
+        sage: tmp_root2 = tmp_dir()
+        sage: makeGroupData(8,3,folder=tmp_root2,in_process=True)
+        sage: all(open(os.path.join(tmp_root,s,s+'.nontips')).read() == open(os.path.join(tmp_root2,s,s+'.nontips')).read() for s in ['2gp1','4gp2','8gp3'])
+        True
+        sage: os.path.exists(os.path.join(tmp_root2,'8gp3','8gp3.reg'))
+        False
+        sage: M == MTX.from_filename(os.path.join(tmp_root2,'8gp3','sgp','8gp3sg3.ima'))
+        True
+
     """
     import os
     _gap_reset_random_seed()
@@ -213,82 +365,126 @@ def makeGroupData(q,n, folder, ElAb=False, Forced=False):
     folder = str(folder)
     if not ElAb:  # we will create data for all smaller elementary abelian groups
         for i in xrange(1,F[0][1]):
-            makeGroupData(F[0][0]**i, gap.NumberSmallGroups(F[0][0]**i).sage(), folder, True, Forced)
+            makeGroupData(F[0][0]**i, gap.NumberSmallGroups(F[0][0]**i).sage(), folder, True, Forced, in_process)
     GStem = "{:d}gp{:d}".format(q, n)
     if folder == '':
         gps_folder = GStem
     else:
         gps_folder = os.path.join(folder, GStem)
-    if os.access(os.path.join(gps_folder,GStem+'.nontips'),os.R_OK):
-        if Forced:
-            coho_logger.info("Forcing recomputation of group data for %s",None,GStem)
+    # Processes sharing the folder must not create the same data at the same time
+    with workspace_lock(folder, GStem):
+        if os.access(os.path.join(gps_folder,GStem+'.nontips'),os.R_OK):
+            if Forced:
+                coho_logger.info("Forcing recomputation of group data for %s",None,GStem)
+            else:
+                return
+        coho_logger.info( "Computing basic setup for Small Group number %d of order %d"%(n,q), None)
+        ## clean the folder, in order to avoid being asked questions...
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.bch'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.bch.gz'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.gens'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.gens.gz'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.lgens'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.lgens.gz'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.snap'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.bch'))
+        except OSError:
+            pass
+        try:
+            os.remove(os.path.join(gps_folder,GStem+'.bch.gz'))
+        except OSError:
+            pass
+        ## finally, construct the data
+        if in_process:
+            if not os.path.exists(gps_folder):
+                os.makedirs(gps_folder)
+            gap.eval('pGroupCohomologyRegularImages := regularPermutationImages(SmallGroup(%d,%d))'%(q,n))
+            perms = gap('pGroupCohomologyRegularImages').sage()
+            build_group_files(os.path.join(gps_folder,GStem), F[0][0], perms)
+            gap.eval('completeThisSmallGroup([%d,%d],"%s",Group(List(pGroupCohomologyRegularImages, PermList)))'%(q,n,folder))
         else:
+            gap.eval('makeThisSmallGroup([%d,%d],"%s")'%(q,n,folder))
+        # there seems to be a racing condition when creating the .ima files,
+        # which becomes immanent when doing parallel tests. So,
+        # we verify that the files are OK before returning.
+        # 1. test if the sgs is there. If it isn,t then it is safe to think
+        # that we have an (elementary) abelian group.
+        inc_folder = os.path.join(gps_folder,'sgp')
+        try:
+            L = gap.ReadAsFunction(os.path.join(inc_folder,GStem+'.sgs'))()
+        except TypeError:  # can't be loaded
             return
-    coho_logger.info( "Computing basic setup for Small Group number %d of order %d"%(n,q), None)
-    ## clean the folder, in order to avoid being asked questions...
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.bch'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.bch.gz'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.gens'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.gens.gz'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.lgens'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.lgens.gz'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.bch'))
-    except OSError:
-        pass
-    try:
-        os.remove(os.path.join(gps_folder,GStem+'.bch.gz'))
-    except OSError:
-        pass
-    ## finally, construct the data
-    gap.eval('makeThisSmallGroup([%d,%d],"%s")'%(q,n,folder))
-    # there seems to be a racing condition when creating the .ima files,
-    # which becomes immanent when doing parallel tests. So,
-    # we verify that the files are OK before returning.
-    # 1. test if the sgs is there. If it isn,t then it is safe to think
-    # that we have an (elementary) abelian group.
-    inc_folder = os.path.join(gps_folder,'sgp')
-    try:
-        L = gap.ReadAsFunction(os.path.join(inc_folder,GStem+'.sgs'))()
-    except TypeError:  # can't be loaded
-        return
-    NumSubgps = Integer(L[0])
-    for sg in range(1,NumSubgps+1):
-        cr = 0
-        filename = os.path.join(inc_folder,GStem+'sg%d.ima'%sg)
-        filename = str_to_bytes(filename, FS_ENCODING, 'surrogateescape')
-        # There is a race condition. So, we need to try reading until
-        # the gap subprocess is done writing the file.
-        while(1):
-            cr += 1
-            if cr >= 1000000:
-                raise IOError('File "%s" has not been created')
-            try:
-                mat = MatLoad(filename)
-            except OSError:
-                continue
-            if mat != NULL:  # finally the file is written and readable!
-                break
+        NumSubgps = Integer(L[0])
+        for sg in range(1,NumSubgps+1):
+            cr = 0
+            filename = os.path.join(inc_folder,GStem+'sg%d.ima'%sg)
+            filename = str_to_bytes(filename, FS_ENCODING, 'surrogateescape')
+            # There is a race condition. So, we need to try reading until
+            # the gap subprocess is done writing the file.
+            while(1):
+                cr += 1
+                if cr >= 1000000:
+                    raise IOError('File "%s" has not been created')
+                try:
+                    mat = MatLoad(filename)
+                except OSError:
+                    continue
+                if mat != NULL:  # finally the file is written and readable!
+                    break
 #~         M = new_mtx(mat)
 
+def makeGroupDataBatch(L, folder, Forced=False):
+    """
+    Create the basic data files for a list of groups from the SmallGroups library.
+
+    INPUT:
+
+    - ``L`` -- an iterable of pairs ``(q,n)``, addresses in the SmallGroups library
+    - ``folder`` -- name of a directory in which the data files will be stored
+    - ``Forced`` (optional bool, default False) -- if True, force
+      recomputation.
+
+    The data are computed as by :func:`makeGroupData` with ``in_process=True``,
+    one group after the other, so that the list may be a generator that
+    is consumed while the data are created. Data of the elementary
+    abelian subgroups are only created once.
+
+    EXAMPLES::
+
+        sage: from pGroupCohomology.resolution import makeGroupDataBatch
+        sage: tmp_root = tmp_dir()
+        sage: makeGroupDataBatch(((8,n) for n in range(1,6)), tmp_root)
+        sage: sorted(f for f in os.listdir(tmp_root) if f.startswith('8gp'))
+        ['8gp1', '8gp2', '8gp3', '8gp4', '8gp5']
+        sage: print(open(os.path.join(tmp_root,'8gp3','8gp3.nontips')).read().split('\n')[0])
+        2 8 4 3 2 R
+
+    """
+    for q, n in L:
+        makeGroupData(q, n, folder, Forced=Forced, in_process=True)
+
 def makeSpecialGroupData(H, GStem, folder):
     """
     Creating data files for computing the cohomology of a finite `p`-Group.
@@ -417,6 +613,10 @@ def makeSpecialGroupData(H, GStem, folder):
         os.remove(os.path.join(gps_folder,GStem+'.lgens.gz'))
     except OSError:
         pass
+    try:
+        os.remove(os.path.join(gps_folder,GStem+'.snap'))
+    except OSError:
+        pass
     try:
         os.remove(os.path.join(gps_folder,GStem+'.bch'))
     except OSError:
@@ -495,7 +695,7 @@ class RESL_sparse_unpickle_class:
 
         """
         self.__safe_for_unpickling__ = True
-    def __call__(self,gstem,gps_folder,res_folder,degree,Lifts,Autolift,Action, ROOT = None):
+    def __call__(self,gstem,gps_folder,res_folder,degree,Lifts,Autolift,Action, ROOT = None, LiftCache = None):
         """
         TESTS::
 
@@ -590,11 +790,31 @@ class RESL_sparse_unpickle_class:
                 OUT.Autolift['Piv'] = tuple(OUT.Autolift['Piv'])
         OUT.Action = Action
         OUT.exportAction()
+        if LiftCache is not None:
+            OUT.Lifts.set_limit(*LiftCache)
         return OUT
 
 resl_sparse_unpickle = RESL_sparse_unpickle_class()
 
 
+cdef dict buchberger_statistics(bStat_t S, bStat_t T):
+    """
+    Combine the statistics of the Buchberger algorithm for two generating sets.
+    """
+    return {'expansions': S.expansions+T.expansions,
+            'expand_time': S.expandTime+T.expandTime,
+            'products': S.products+T.products,
+            'product_time': S.productTime+T.productTime,
+            'block_reads': S.blockReads+T.blockReads,
+            'block_bytes': S.blockBytes+T.blockBytes,
+            'read_time': S.readTime+T.readTime,
+            'reductions': S.reductions+T.reductions,
+            'reduce_time': S.reduceTime+T.reduceTime,
+            'promotions': S.promotions+T.promotions,
+            'demotions': S.demotions+T.demotions,
+            'unfruitful': S.unfruitful+T.unfruitful,
+            'overshoot': S.overshoot+T.overshoot}
+
 cdef class RESL:
     r"""
     Computating minimal projective resolutions for finite `p`-groups with coefficients in ``GF(p)``.
@@ -1055,9 +1275,14 @@ cdef class RESL:
         self.G_Alg.groupname = groupname
         self.Lifts = LIFTcontainer(self)
         self.Autolift = {}
+        self.BuchStats = {}
         self.ugb_deg = 0
         self.Action = [ self.G_Alg.r_action(baseMTX(self.G_Alg.Data.p, 1,self.G_Alg.Data.nontips, 0,i)) for i in range(self.G_Alg.Data.nontips)]
         self._Action_saved = 0
+        if coho_options['action_cache']:
+            self.set_action_cache(coho_options['action_cache'])
+        if coho_options['lift_cache']:
+            self.set_lift_cache(coho_options['lift_cache'], coho_options['lift_cache_policy'])
         self.exportAction()
 
     def __dealloc__(self):
@@ -1184,11 +1409,12 @@ cdef class RESL:
             Lifts.append((X,s))
         r = os.path.split(self.gps_folder)[0]
         from pGroupCohomology.cohomology import COHO
+        LiftCache = self.Lifts.limits()
         if r == COHO.local_sources:
-            return resl_sparse_unpickle, (self.gstem,self.gps_folder,self.res_folder,self.deg(),Lifts,self.Autolift,self.Action,'@public_db@')
+            return resl_sparse_unpickle, (self.gstem,self.gps_folder,self.res_folder,self.deg(),Lifts,self.Autolift,self.Action,'@public_db@', LiftCache)
         if r == COHO.workspace:
-            return resl_sparse_unpickle, (self.gstem,self.gps_folder,self.res_folder,self.deg(),Lifts,self.Autolift,self.Action, '@user_db@')
-        return resl_sparse_unpickle, (self.gstem,self.gps_folder,self.res_folder,self.deg(),Lifts,self.Autolift,self.Action)
+            return resl_sparse_unpickle, (self.gstem,self.gps_folder,self.res_folder,self.deg(),Lifts,self.Autolift,self.Action, '@user_db@', LiftCache)
+        return resl_sparse_unpickle, (self.gstem,self.gps_folder,self.res_folder,self.deg(),Lifts,self.Autolift,self.Action, None, LiftCache)
 
     def __str__(self):
         """
@@ -1358,7 +1584,7 @@ cdef class RESL:
                 raise IndexError("Index out of range")
             else:
                 if isinstance(self.Diff[key-1], (str, unicode)):
-                    return MTX.from_filename(str(self.Diff[key-1]))
+                    return load_stored_matrix(self.Diff[key-1])
                 else:
                     return self.Diff[key-1]
         else:
@@ -1904,21 +2130,27 @@ cdef class RESL:
             self.nRgs = loadUrbildGroebnerBasis(self.Data, d)
             self.ugb_deg = d
 
-#########################
-# ==, <, >
-    def __richcmp__(RESL self, RESL S, int x):
+    def set_action_cache(self, megabytes):
         """
-        ``R <= S`` if and only if ``R`` coincides with the first terms of ``S``.
+        Cache the action matrices of the basis elements of the group algebra.
 
-        EXAMPLES:
+        INPUT:
 
-        First, we create the basic data for the dihedral group of order 8
-        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+        ``megabytes`` -- the memory that may be used by the cache. If it is
+        zero, the cache is disabled and its memory is freed.
+
+        NOTE:
+
+        With the cache, the action matrix of a vector with few nonzero
+        coefficients, as it occurs in the composition of chain maps,
+        is obtained as a linear combination of cached matrices.
+        The cache lives as long as the resolution. By default, its size
+        is given by ``coho_options['action_cache']``.
+
+        EXAMPLES::
 
             sage: tmp_root = tmp_dir()
             sage: from pGroupCohomology.resolution import makeGroupData, RESL
-            sage: from pGroupCohomology import CohomologyRing
-            sage: CohomologyRing.reset()
             sage: makeGroupData(8,3,folder=tmp_root)
             sage: gstem='8gp3'
             sage: gps_folder=os.path.join(tmp_root,gstem)
@@ -1927,123 +2159,415 @@ cdef class RESL:
             sage: R.nextDiff()
             sage: R.nextDiff()
             sage: R.nextDiff()
-            sage: S = copy(R)
-            sage: S.nextDiff()
-            sage: R==S   # indirect doctest
-            False
-            sage: R<S
+            sage: X = R.composeChainMaps(R[3],R[2],3,2,1)
+            sage: R.set_action_cache(1)
+            sage: R.composeChainMaps(R[3],R[2],3,2,1) == X
             True
-            sage: S>=R
+            sage: stats = R.action_cache_stats()
+            sage: stats['bytes'] > 0
             True
+            sage: R.set_action_cache(0)
+            sage: R.action_cache_stats()['bytes']
+            0
 
         """
-        # < 0, <= 1, == 2, != 3, > 4, >= 5
-        if x==0:
-            return (self.G_Alg<=S.G_Alg) and (self.Diff<S.Diff)
-        if x==1:
-            return (self.G_Alg<=S.G_Alg) and (self.Diff<=S.Diff)
-        if x==2:
-            return (self.G_Alg==S.G_Alg) and (self.Diff==S.Diff)
-        if x==3:
-            return (self.G_Alg!=S.G_Alg) or (self.Diff!=S.Diff)
-        if x==4:
-            return (self.G_Alg>=S.G_Alg) and (self.Diff>S.Diff)
-        return (self.G_Alg>=S.G_Alg) and (self.Diff>=S.Diff)
-
+        selectField(self.G_Alg.Data.p, self.G_Alg.Data.nontips)
+        enableActionMatrixCache(self.G_Alg.Data, int(megabytes*(1<<20)))
 
-#########################
-# Construct the resolution
-    def firstDiff(self):
+    def action_cache_stats(self):
         """
-        Make first differential for ``self``.
+        Statistics of the cache of action matrices.
 
-        This function is usually called from nextDiff().
+        OUTPUT:
 
-        EXAMPLES:
+        A dictionary providing the memory used by the cache (in bytes),
+        and the number of hits and misses.
 
-        First, we create the basic data for the dihedral group of order 8
-        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+        EXAMPLES::
 
             sage: tmp_root = tmp_dir()
             sage: from pGroupCohomology.resolution import makeGroupData, RESL
-            sage: from pGroupCohomology import CohomologyRing
-            sage: CohomologyRing.reset()
             sage: makeGroupData(8,3,folder=tmp_root)
             sage: gstem='8gp3'
             sage: gps_folder=os.path.join(tmp_root,gstem)
             sage: res_folder=os.path.join(gps_folder,'dat')
             sage: R=RESL(gstem,gps_folder,res_folder)
-            sage: R.firstDiff()
-            sage: print(R)
-            Resolution:
-            0 <- GF(2) <- GF(2)[8gp3] <- rank 2
+            sage: sorted(R.action_cache_stats().items())
+            [('bytes', 0), ('hits', 0), ('misses', 0)]
 
-        An error is raised if it is attempted to compute the first term again.
-        ::
+        """
+        cdef long nbytes, hits, misses
+        actionMatrixCacheStatistics(self.G_Alg.Data, &nbytes, &hits, &misses)
+        return {'bytes': nbytes, 'hits': hits, 'misses': misses}
 
-            sage: R.firstDiff()
-            Traceback (most recent call last):
-            ...
-            IndexError: First differential is already computed
+    def set_lift_cache(self, megabytes, policy='lru'):
+        """
+        Bound the memory used by the cached lifts of chain maps.
+
+        INPUT:
+
+        - ``megabytes`` -- the memory that may be used by cached lifts.
+          If it is zero, there is no limit.
+        - ``policy`` (optional string, default ``'lru'``) -- ``'lru'`` or
+          ``'degree'``, see :meth:`LIFTcontainer.set_limit`.
+
+        NOTE:
+
+        Lifts exceeding the limit are stored in the resolution's folder
+        and reloaded on demand. By default, the limit and the policy are
+        given by ``coho_options['lift_cache']`` and
+        ``coho_options['lift_cache_policy']``.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: from pGroupCohomology.cochain import COCH
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(8,3, from_scratch=True)
+            sage: R = H.resolution()
+            sage: R.set_lift_cache(1)
+            sage: for i in range(5):
+            ....:     R.nextDiff()
+            sage: C = COCH(H,2,'C',[1,0,1])
+            sage: R.liftCochains([C], 4)
+            sage: stats = R.lift_cache_stats()
+            sage: stats['bytes'] > 0, stats['evictions'], stats['limit']
+            (True, 0, 1048576)
+
+        The limit and the policy are preserved by pickling::
+
+            sage: R.set_lift_cache(2, 'degree')
+            sage: stats = loads(dumps(R)).lift_cache_stats()
+            sage: stats['limit'], stats['policy']
+            (2097152, 'degree')
 
         """
-        FfSetField(self.G_Alg.Data.p)
-        FfSetNoc(self.G_Alg.Data.nontips)
-        cdef MTX M
-        if len(self.Diff):
-            raise IndexError("First differential is already computed")
-        M = new_mtx(makeFirstDifferential(self.Data),None)
-        M.set_immutable()
-        self.Diff = [M]
+        self.Lifts.set_limit(int(megabytes*(1<<20)), policy)
 
-    def nextDiff(self):
+    def lift_cache_stats(self):
         """
-        Compute next unknown differential of the resolution.
+        Statistics of the cached lifts of chain maps.
 
-        EXAMPLES:
+        OUTPUT:
 
-        First, we create the basic data for the dihedral group of order 8
-        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+        A dictionary providing the memory used by the lifts in memory
+        (in bytes), the number of hits and misses, the number of
+        times that lifts were stored on disk to meet the memory limit,
+        and the memory limit (in bytes) and eviction policy.
+
+        EXAMPLES::
 
             sage: tmp_root = tmp_dir()
             sage: from pGroupCohomology.resolution import makeGroupData, RESL
-            sage: from pGroupCohomology import CohomologyRing
-            sage: CohomologyRing.reset()
             sage: makeGroupData(8,3,folder=tmp_root)
             sage: gstem='8gp3'
             sage: gps_folder=os.path.join(tmp_root,gstem)
             sage: res_folder=os.path.join(gps_folder,'dat')
             sage: R=RESL(gstem,gps_folder,res_folder)
-            sage: R
-            Resolution of GF(2)[8gp3]
+            sage: sorted(R.lift_cache_stats().items())
+            [('bytes', 0), ('evictions', 0), ('hits', 0), ('limit', 0), ('misses', 0), ('policy', 'lru')]
 
-        So far, only term number zero of the resolution was created. We compute up to term
-        number four::
+        """
+        cdef dict D = self.Lifts.statistics()
+        D['limit'], D['policy'] = self.Lifts.limits()
+        return D
 
-            sage: R.nextDiff()
-            sage: R.nextDiff()
-            sage: R.nextDiff()
-            sage: R.nextDiff()
-            sage: print(R)
-            Resolution:
-            0 <- GF(2) <- GF(2)[8gp3] <- rank 2 <- rank 3 <- rank 4 <- rank 5
-            sage: R[3]
-            [0 1 0 0 0 0 0 0]
-            [0 0 0 0 0 0 0 0]
-            [0 0 0 0 0 0 0 0]
-            [0 0 0 0 0 0 0 0]
-            [0 0 1 0 0 0 0 0]
-            [0 0 0 0 0 0 0 0]
-            [0 0 0 0 0 0 1 0]
+    def buchberger_stats(self, n=None):
+        """
+        Statistics of the Buchberger algorithm used to compute the differentials.
+
+        INPUT:
+
+        ``n`` (optional integer): Degree of a differential.
+
+        OUTPUT:
+
+        A dictionary with the statistics of the computation of the
+        ``n``-th differential, combined for the Groebner bases of
+        the image and of the kernel:
+
+        - ``'expansions'``, ``'expand_time'``: Number of and time for the
+          expansions of one level of the word forest.
+        - ``'products'``, ``'product_time'``: Number of rows computed
+          for the slices of products, and the time needed.
+        - ``'block_reads'``, ``'block_bytes'``, ``'read_time'``: Number and
+          size of blocks of products read from disk, and the time needed.
+        - ``'reductions'``, ``'reduce_time'``: Number of and time for
+          reductions of leading terms.
+        - ``'promotions'``, ``'demotions'``: Number of vectors that became
+          reduced resp. unreduced.
+        - ``'unfruitful'``: Number of expansions that did not decrease the
+          number of nontips.
+        - ``'overshoot'``: How often the number of unfruitful expansions
+          reached the overshoot.
+
+        Times are given in seconds; the time for block reads is also
+        contained in the time for expansions and reductions. Times are
+        only taken if the option ``'buchberger_timing'`` is set, since
+        this slows down the computation; otherwise they are zero. Without
+        argument, a dictionary of the statistics in all degrees that were
+        computed (and not just reloaded) is returned.
+
+        EXAMPLES::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: sorted(R.buchberger_stats().keys())
+            [2, 3]
+            sage: S = R.buchberger_stats(3)
+            sage: S['expansions'] > 0 and S['products'] > 0
+            True
+            sage: S['block_reads']
+            0
+            sage: S['reduce_time']
+            0.0
+
+        With the option ``'buchberger_timing'``, the times are taken::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.global_options('buchberger_timing')
+            sage: R.nextDiff()
+            sage: R.buchberger_stats(4)['expand_time'] > 0
+            True
+            sage: CohomologyRing.global_options('nobuchberger_timing')
+
+        The first differential is not computed by the Buchberger algorithm::
+
+            sage: R.buchberger_stats(1)
+            Traceback (most recent call last):
+            ...
+            KeyError: 1
+
+        """
+        if self.BuchStats is None:
+            self.BuchStats = {}
+        if n is None:
+            return dict(self.BuchStats)
+        return dict(self.BuchStats[n])
+
+#########################
+# ==, <, >
+    def __richcmp__(RESL self, RESL S, int x):
+        """
+        ``R <= S`` if and only if ``R`` coincides with the first terms of ``S``.
+
+        EXAMPLES:
+
+        First, we create the basic data for the dihedral group of order 8
+        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.reset()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: S = copy(R)
+            sage: S.nextDiff()
+            sage: R==S   # indirect doctest
+            False
+            sage: R<S
+            True
+            sage: S>=R
+            True
+
+        """
+        # < 0, <= 1, == 2, != 3, > 4, >= 5
+        if x==0:
+            return (self.G_Alg<=S.G_Alg) and (self.Diff<S.Diff)
+        if x==1:
+            return (self.G_Alg<=S.G_Alg) and (self.Diff<=S.Diff)
+        if x==2:
+            return (self.G_Alg==S.G_Alg) and (self.Diff==S.Diff)
+        if x==3:
+            return (self.G_Alg!=S.G_Alg) or (self.Diff!=S.Diff)
+        if x==4:
+            return (self.G_Alg>=S.G_Alg) and (self.Diff>S.Diff)
+        return (self.G_Alg>=S.G_Alg) and (self.Diff>=S.Diff)
+
+
+#########################
+# Construct the resolution
+    def firstDiff(self):
+        """
+        Make first differential for ``self``.
+
+        This function is usually called from nextDiff().
+
+        EXAMPLES:
+
+        First, we create the basic data for the dihedral group of order 8
+        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.reset()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R.firstDiff()
+            sage: print(R)
+            Resolution:
+            0 <- GF(2) <- GF(2)[8gp3] <- rank 2
+
+        An error is raised if it is attempted to compute the first term again.
+        ::
+
+            sage: R.firstDiff()
+            Traceback (most recent call last):
+            ...
+            IndexError: First differential is already computed
+
+        """
+        selectField(self.G_Alg.Data.p, self.G_Alg.Data.nontips)
+        cdef MTX M
+        if len(self.Diff):
+            raise IndexError("First differential is already computed")
+        M = new_mtx(makeFirstDifferential(self.Data),None)
+        M.set_immutable()
+        self.Diff = [M]
+
+    def nextDiff(self, keep_checkpoint=False):
+        """
+        Compute next unknown differential of the resolution.
+
+        INPUT:
+
+        ``keep_checkpoint`` -- (optional bool, default ``False``) whether
+        to keep the checkpoint of the differential (see below) after its
+        computation. This is only useful for testing the resumption from
+        a checkpoint.
+
+        EXAMPLES:
+
+        First, we create the basic data for the dihedral group of order 8
+        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.reset()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R
+            Resolution of GF(2)[8gp3]
+
+        So far, only term number zero of the resolution was created. We compute up to term
+        number four::
+
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: print(R)
+            Resolution:
+            0 <- GF(2) <- GF(2)[8gp3] <- rank 2 <- rank 3 <- rank 4 <- rank 5
+            sage: R[3]
+            [0 1 0 0 0 0 0 0]
+            [0 0 0 0 0 0 0 0]
+            [0 0 0 0 0 0 0 0]
+            [0 0 0 0 0 0 0 0]
+            [0 0 1 0 0 0 0 0]
+            [0 0 0 0 0 0 0 0]
+            [0 0 0 0 0 0 1 0]
             [0 0 0 0 0 0 0 0]
             [0 1 0 0 0 0 0 0]
             [0 0 0 0 0 0 0 0]
             [0 0 0 0 0 1 0 0]
             [0 0 1 0 0 0 0 0]
 
+        If ``coho_options['threads']`` is bigger than one, the products
+        in the Buchberger algorithm are computed by that many threads.
+        Products of up to ``coho_options['slice_memory']`` megabytes are
+        kept in memory, larger slices of products are stored on disk. Of
+        the latter, ``coho_options['block_cache']`` blocks are cached.
+        The result depends neither on the number of threads nor on the
+        memory used for the products::
+
+            sage: CohomologyRing.global_options(threads=4)
+            sage: R2 = RESL(gstem,gps_folder,tmp_dir())
+            sage: for i in range(4):
+            ....:     R2.nextDiff()
+            sage: all(R2[i] == R[i] for i in range(1,5))
+            True
+            sage: CohomologyRing.global_options(threads=1, slice_memory=0)
+            sage: R3 = RESL(gstem,gps_folder,tmp_dir())
+            sage: for i in range(4):
+            ....:     R3.nextDiff()
+            sage: all(R3[i] == R[i] for i in range(1,5))
+            True
+
+        If ``coho_options['checkpoint']`` is positive, the state of the
+        Buchberger algorithm is saved whenever that many seconds have passed
+        since the previous checkpoint. If the computation of the differential
+        is interrupted, it is resumed from the checkpoint by the next call
+        to this method. The checkpoint is removed when the differential
+        is computed::
+
+            sage: CohomologyRing.global_options(slice_memory=128, checkpoint=1e-6)
+            sage: res4 = tmp_dir()
+            sage: R4 = RESL(gstem,gps_folder,res4)
+            sage: for i in range(4):
+            ....:     R4.nextDiff()
+            sage: all(R4[i] == R[i] for i in range(1,5))
+            True
+            sage: [f for f in os.listdir(res4) if f.endswith('.ckp')]
+            []
+
+        We simulate an interruption of the computation of the sixth
+        differential after its last checkpoint: The checkpoint is kept,
+        and the results of the computation are removed. The computation
+        is then resumed from the checkpoint, with the same result. Since
+        the statistics are part of the checkpoint, the resumed computation
+        counts as many expansions of the word forest as the original one::
+
+            sage: for i in range(2):
+            ....:     R4.nextDiff()
+            sage: res5 = tmp_dir()
+            sage: R5 = RESL(gstem,gps_folder,res5)
+            sage: for i in range(5):
+            ....:     R5.nextDiff()
+            sage: R5.nextDiff(keep_checkpoint=True)
+            sage: ckp = os.path.join(res5, 'Res'+gstem+'d06.ckp')
+            sage: os.path.exists(ckp)
+            True
+            sage: os.remove(os.path.join(res5, 'Res'+gstem+'d06.bin'))
+            sage: os.remove(os.path.join(res5, 'Res'+gstem+'d05.ugb'))
+            sage: R6 = RESL(gstem,gps_folder,res5)
+            sage: for i in range(6):
+            ....:     R6.nextDiff()
+            sage: R6[6] == R4[6]
+            True
+            sage: os.path.exists(ckp)
+            False
+            sage: R6.buchberger_stats(6)['expansions'] == R5.buchberger_stats(6)['expansions']
+            True
+            sage: CohomologyRing.reset()
+
         """
-        FfSetField(self.G_Alg.Data.p)
-        FfSetNoc(self.G_Alg.Data.nontips)
+        if self._worker is not None: # differentials may be computed by compute_ahead
+            self._wait_for_worker(len(self.Diff)+1)
+        selectField(self.G_Alg.Data.p, self.G_Alg.Data.nontips)
         cdef group_t *G
         G = self.Data.group
         # kind of "loadDifferential":
@@ -2054,9 +2578,9 @@ cdef class RESL:
         if n==1:
             self.firstDiff()
             return
-        try:
-            M = MTX.from_filename(differentialFile(self.Data, n))
-        except OSError:
+        if os.path.exists(bytes_to_str(differentialFile(self.Data, n))):
+            M = load_stored_matrix(bytes_to_str(differentialFile(self.Data, n)))
+        else:
             M = None
         if M is not None: # if the differential was computed before
             assert M.Data != NULL and M.Data.Data != NULL, "Stored differential was empty"
@@ -2068,37 +2592,308 @@ cdef class RESL:
             coho_logger.info("Differential reloaded", self)
             coho_logger.info("> rk P_%02ld = %3ld"%(n, self.Data.projrank[n]), self)
             return
-        # we have to construct the next differential from scratch
-        coho_logger.info("Computing next term", self)
-        M = self[n-1]
-        cdef nFgs_t *ker
-        sig_on()
-        try:
-            nRgs = nRgsStandardSetup(self.Data, n-1, M.Data.Data)
-            ker = nRgs.ker
-            nRgsBuchberger(nRgs, G)
-            setRankProj(self.Data, n, numberOfHeadyVectors(ker.ngs))
-        finally:
-            sig_off()
-        coho_logger.info("> rk P_%02ld = %3ld"%(n, self.Data.projrank[n]), self)
-        sig_on()
-        try:
-            mat = getMinimalGenerators(ker, G)
-        finally:
-            sig_off()
-        M = new_mtx(mat , M)
-        M.set_immutable()
-        sig_on()
+        # we have to construct the next differential from scratch
+        M = self[n-1]
+        cdef nFgs_t *ker
+        cdef bytes ckp = checkpointFile(self.Data, n)
+        resume = os.path.exists(bytes_to_str(ckp))
+        if resume:
+            coho_logger.info("Resuming computation of next term from checkpoint", self)
+        else:
+            coho_logger.info("Computing next term", self)
+        sig_on()
+        try:
+            if resume:
+                nRgs = nRgsCheckpointSetup(self.Data, n-1, ckp)
+            else:
+                nRgs = nRgsStandardSetup(self.Data, n-1, M.Data.Data)
+            nRgsSetThreads(nRgs, coho_options['threads'])
+            nRgsSetSliceMemory(nRgs, coho_options['slice_memory']<<20)
+            nRgsSetBlockCache(nRgs, coho_options['block_cache'])
+            nRgsSetCheckpoint(nRgs, ckp, coho_options['checkpoint'])
+            nRgsSetCompression(nRgs, coho_options['compress'])
+            nRgsSetTiming(nRgs, coho_options['buchberger_timing'])
+            ker = nRgs.ker
+            nRgsBuchberger(nRgs, G)
+            setRankProj(self.Data, n, numberOfHeadyVectors(ker.ngs))
+        finally:
+            sig_off()
+        coho_logger.debug("Block cache: %d hits, %d misses"%(nRgs.ngs.cacheHits+ker.ngs.cacheHits, nRgs.ngs.cacheMisses+ker.ngs.cacheMisses), self)
+        if self.BuchStats is None:
+            self.BuchStats = {}
+        self.BuchStats[n] = buchberger_statistics(nRgs.ngs.stats, ker.ngs.stats)
+        coho_logger.info("> rk P_%02ld = %3ld"%(n, self.Data.projrank[n]), self)
+        sig_on()
+        try:
+            mat = getMinimalGenerators(ker, G)
+        finally:
+            sig_off()
+        M = new_mtx(mat , M)
+        M.set_immutable()
+        sig_on()
+        try:
+            saveUrbildGroebnerBasis(nRgs, urbildGBFile(self.Data, n-1), G)
+            if coho_options['compress']:
+                compressMatrixFile(urbildGBFile(self.Data, n-1), 0)
+                compressedMatSave(M.Data, differentialFile(self.Data, n), 0)
+            elif coho_options['sparse_files']:
+                sparsifyMatrixFile(urbildGBFile(self.Data, n-1))
+                sparseMatSave(M.Data, differentialFile(self.Data, n))
+            else:
+                MatSave(M.Data, differentialFile(self.Data, n))
+        finally:
+            sig_off()
+        if coho_options['sparse']:
+            self.Diff.append(bytes_to_str(differentialFile(self.Data, n)))
+        else:
+            self.Diff.append(M)
+        freeNRgs(nRgs)
+        if os.path.exists(bytes_to_str(ckp)) and not keep_checkpoint:
+            os.remove(bytes_to_str(ckp))
+
+    def compute_ahead(self, N):
+        """
+        Compute the differentials out to degree ``N`` in a background process.
+
+        INPUT:
+
+        ``N`` -- integer, the degree out to which the resolution shall be computed
+
+        OUTPUT:
+
+        ``True`` if a background process was started, ``False`` otherwise.
+
+        NOTE:
+
+        The computation is done in a forked process, since the MeatAxe
+        is not thread safe. The background process stores the differentials
+        and Urbild Groebner bases on disk, but does not modify ``self``.
+        Whenever it has completed a degree, it creates a marker file.
+        :meth:`nextDiff` only waits until the marker of the next degree
+        exists and then reloads the differential, while the background
+        process carries on with the higher degrees. If a background process
+        is still running, then no new process is started.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.reset()
+            sage: tmp_root = tmp_dir()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: R.compute_ahead(4)
+            True
+            sage: CohomologyRing.global_options('info')
+            sage: R.nextDiff()
+            Resolution of GF(2)[8gp3]:
+                Differential reloaded
+                > rk P_03 =   4
+            sage: R.nextDiff()
+                Differential reloaded
+                > rk P_04 =   5
+            sage: CohomologyRing.global_options('warn')
+
+        There is nothing to do if the differentials are known::
+
+            sage: R.compute_ahead(4)
+            False
+
+        The differentials are reloaded as soon as they are available; in
+        particular, :meth:`nextDiff` does not wait until the background
+        process has computed all differentials::
+
+            sage: R.compute_ahead(100)
+            True
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: os.path.exists(os.path.join(res_folder, 'Res'+gstem+'d100.bin'))
+            False
+            sage: R._join_worker(kill=True)
+            sage: R.rank(6)
+            7
+
+        """
+        if self._worker is not None:
+            pid = self._worker[0]
+            try:
+                if os.waitpid(pid, os.WNOHANG)[0] == 0:
+                    return False
+            except OSError:
+                pass
+            self._join_worker()
+        cdef list new = [m for m in range(self.Data.numproj+1, N+1)
+                         if not os.path.exists(bytes_to_str(differentialFile(self.Data, m)))]
+        if not new:
+            return False
+        for m in new: # remove markers left over from a previous session
+            if os.path.exists(self._done_file(m)):
+                os.remove(self._done_file(m))
+        sys.stdout.flush()
+        sys.stderr.flush()
+        pid = os.fork()
+        if pid == 0:
+            status = 1
+            try:
+                import logging
+                coho_logger.setLevel(logging.WARN)
+                while self.Data.numproj < N:
+                    self.nextDiff()
+                    if self.Data.numproj in new:
+                        open(self._done_file(self.Data.numproj), 'w').close()
+                status = 0
+            finally:
+                os._exit(status)
+        coho_logger.debug("Computing differentials %d to %d in process %d"%(new[0], new[-1], pid), self)
+        self._worker = (pid, N, new)
+        return True
+
+    def _done_file(self, m):
+        """
+        Name of the file that marks the completion of degree ``m`` by :meth:`compute_ahead`.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: tmp_root = tmp_dir()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gps_folder = os.path.join(tmp_root,'8gp3')
+            sage: R = RESL('8gp3',gps_folder,os.path.join(gps_folder,'dat'))
+            sage: os.path.basename(R._done_file(3))
+            'Res8gp3d03.done'
+
+        """
+        return os.path.join(self.res_folder, self.rstem)+'d%02d.done'%m
+
+    def _wait_for_worker(self, n):
+        """
+        Wait until the background process of :meth:`compute_ahead` has computed degree ``n``.
+
+        If the background process terminates without computing it, or if
+        ``n`` exceeds the degree out to which the background process computes,
+        then :meth:`_join_worker` is called.
+
+        TESTS::
+
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: tmp_root = tmp_dir()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gps_folder = os.path.join(tmp_root,'8gp3')
+            sage: R = RESL('8gp3',gps_folder,os.path.join(gps_folder,'dat'))
+            sage: R.nextDiff()
+            sage: R.compute_ahead(5)
+            True
+            sage: R._wait_for_worker(4)
+            sage: os.path.exists(R._done_file(4))
+            True
+            sage: R._wait_for_worker(6)
+            sage: [os.path.exists(R._done_file(m)) for m in range(2,6)]
+            [False, False, False, False]
+
+        """
+        import time
+        pid, N, new = self._worker
+        if n > N:
+            self._join_worker()
+            return
+        if n not in new: # the differential was known before
+            return
+        done = self._done_file(n)
+        while not os.path.exists(done):
+            try:
+                if os.waitpid(pid, os.WNOHANG)[0] != 0:
+                    break
+            except OSError:
+                break
+            time.sleep(0.01)
+        if n == N or not os.path.exists(done):
+            self._join_worker()
+
+    def _join_worker(self, kill=False):
+        """
+        Wait for the background process started by :meth:`compute_ahead`.
+
+        INPUT:
+
+        ``kill`` -- (optional bool, default ``False``) whether to terminate
+        the background process instead of waiting for it.
+
+        The data of the degrees that the background process has completed
+        are kept, whereas the files that it may have left incomplete in the
+        other degrees are removed. Checkpoints are kept, so that
+        :meth:`nextDiff` can resume from them.
+
+        TESTS::
+
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.reset()
+            sage: tmp_root = tmp_dir()
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R.nextDiff()
+            sage: R.compute_ahead(8)
+            True
+            sage: R._join_worker(kill=True)
+            sage: for i in range(7):
+            ....:     R.nextDiff()
+            sage: R.rank(8)
+            9
+
+        Degrees that are completed by the background process survive its
+        termination, even if they have not been reloaded yet::
+
+            sage: R.compute_ahead(100)
+            True
+            sage: R._wait_for_worker(10)
+            sage: R._join_worker(kill=True)
+            sage: all(os.path.exists(os.path.join(res_folder, 'Res'+gstem+'d%02d.bin'%m)) for m in range(9,11))
+            True
+            sage: [f for f in os.listdir(res_folder) if f.endswith('.done')]
+            []
+            sage: CohomologyRing.global_options('info')
+            sage: R.nextDiff()
+            Resolution of GF(2)[8gp3]:
+                Differential reloaded
+                > rk P_09 =  10
+            sage: CohomologyRing.global_options('warn')
+
+        """
+        if self._worker is None:
+            return
+        import glob, signal
+        pid, N, new = self._worker
+        self._worker = None
+        if kill:
+            try:
+                os.kill(pid, signal.SIGKILL)
+            except OSError:
+                pass
         try:
-            saveUrbildGroebnerBasis(nRgs, urbildGBFile(self.Data, n-1), G)
-            MatSave(M.Data, differentialFile(self.Data, n))
-        finally:
-            sig_off()
-        if coho_options['sparse']:
-            self.Diff.append(bytes_to_str(differentialFile(self.Data, n)))
-        else:
-            self.Diff.append(M)
-        freeNRgs(nRgs)
+            os.waitpid(pid, 0)
+        except OSError:
+            pass
+        coho_logger.debug("Removing incomplete data of process %d"%pid, self)
+        stem = os.path.join(self.res_folder, self.rstem)
+        for m in new:
+            if os.path.exists(self._done_file(m)):
+                os.remove(self._done_file(m))
+                continue
+            L = [bytes_to_str(differentialFile(self.Data, m)), bytes_to_str(urbildGBFile(self.Data, m-1)),
+                 bytes_to_str(checkpointFile(self.Data, m))+'.tmp']
+            L.extend(glob.glob(stem+'d%dr*.stp*'%(m-1)))
+            L.extend(glob.glob(stem+'d%df*.stp*'%(m-1)))
+            for f in L:
+                if os.path.exists(f):
+                    os.remove(f)
 
     def makeAutolift(self, d):
         """
@@ -2146,6 +2941,27 @@ cdef class RESL:
                       Compose chain maps R_2 -> R_1 -> R_0
                       > Lift with the autolift method
 
+        TESTS:
+
+        If ``coho_options['useMTX']`` is true, the reduced echelon form
+        needed for the autolift data is computed in C, using
+        ``coho_options['threads']`` threads. Since the reduced echelon
+        form is unique, the result coincides with that obtained with
+        Sage's generic matrices::
+
+            sage: CohomologyRing.global_options('warn')
+            sage: CohomologyRing.set_workspace(tmp_dir())
+            sage: H2 = CohomologyRing(8,3, from_scratch=True, options="nouseMTX")
+            sage: R2 = H2.resolution()
+            sage: R2.nextDiff()
+            sage: R2.nextDiff()
+            sage: R2.nextDiff()
+            sage: R2.makeAutolift(1)
+            sage: C2 = COCH(H2,1,'C',[1,0])
+            sage: (C2*C2).MTX() == D.MTX()
+            True
+            sage: CohomologyRing.reset()
+
         """
         coho_logger.info('Make degree %d autolift data'%(d), self)
         cdef int i,j,k,l
@@ -2167,24 +2983,39 @@ cdef class RESL:
         # keeping track of the pre-images of basis elements
         cdef list L
         cdef Matrix0 M
-        cdef MTX Mmtx
         baseK = GF(fl)
-        cdef PTR DGj_p
-        cdef MTX DGj
+        cdef long rknt = rk*nt
+        cdef MTX M2
+        cdef tuple Piv
+        cdef int lenPiv
+        cdef Matrix_t **DG_p
+        cdef long *Piv_p
+        cdef long npiv
+        cdef Matrix_t *Pre
+        cdef MTX PreMtx
 
         if coho_options['useMTX']:
-            Mmtx = new_mtx(MatAlloc(fl, RK*nt, (rk+RK)*nt), D)
-            FfSetField(fl)
-            FfSetNoc(Mmtx.Data.Noc)
-            for j in range(nt): # "short rows" within a long row of Mmtx
-                DGj = D_G[j]
-                for i in range(RK):
-                    for k in range(rk):
-                        DGj_p = DGj.Data.Data + (i*rk+k)*DGj.Data.RowSize # The k-th row of a block of rk rows of D_G[j]
-                        for l in range(nt):
-                            FfInsert(FfGetPtr(Mmtx.Data.Data,i*nt+j), k*nt+l, FfExtract(DGj_p, l))
-                    Mmtx[i*nt+j, maxK+i*nt+j] = 1
-            M = Mmtx
+            # The reduced echelon form is computed in C; it provides
+            # normalised preimages, sorted by pivots
+            Piv_p = <long *>check_allocarray(RK*nt, sizeof(long))
+            try:
+                DG_p = <Matrix_t **>check_allocarray(nt, sizeof(Matrix_t *))
+                for j in range(nt):
+                    DG_p[j] = (<MTX>D_G[j]).Data
+                sig_on()
+                try:
+                    Pre = autoliftPreimages(DG_p, nt, rk, RK, coho_options['threads'], Piv_p, &npiv)
+                finally:
+                    sig_off()
+                    sig_free(DG_p)
+                PreMtx = new_mtx(Pre, None)
+                Piv = tuple([Piv_p[i] for i in range(npiv)])
+            finally:
+                sig_free(Piv_p)
+            for i in range(npiv):
+                M2 = new_mtx(MatCutRows(PreMtx.Data, i*RK, RK), None)
+                M2.set_immutable()
+                Autolift[Piv[i]] = [()] + [M2._mul_long(ff+1) for ff in range(fl-1)]
         else:
             M = Matrix(baseK, RK*nt, (rk+RK)*nt, 0)  # we begin with zero.
             for i in range(RK): # "long rows" of M
@@ -2194,23 +3025,17 @@ cdef class RESL:
                     for k in range(maxK):
                         M.set_unsafe(i*nt+j, k, baseK(L[k]))
                     M[i*nt+j, maxK+i*nt+j] = 1
-        M.echelonize()
+            M.echelonize()
 
-        # extract preimages
-        cdef tuple Piv = M.pivots()
-        cdef int lenPiv = len(Piv)
-        cdef long rknt = rk*nt
-        cdef MTX M2
-        for i from 0 <= i < lenPiv:
-            if Piv[i]<rknt: # otherwise we got something in the kernel
-                if coho_options['useMTX']:
-                    Mmtx = M
-                    L = Mmtx._rowlist_(i)[rknt:]
-                else:
+            # extract preimages
+            Piv = M.pivots()
+            lenPiv = len(Piv)
+            for i from 0 <= i < lenPiv:
+                if Piv[i]<rknt: # otherwise we got something in the kernel
                     L = list(M[i])[rknt:]
-                M2 = new_mtx(MatMulScalar(rawMatrix(fl, [L[k*nt:(k+1)*nt] for k in range(RK)]), mtx_tmultinv[M[i,Piv[i]]]), None)
-                M2.set_immutable()
-                Autolift[Piv[i]] = [()] + [M2._mul_long(ff+1) for ff in range(fl-1)]
+                    M2 = new_mtx(MatMulScalar(rawMatrix(fl, [L[k*nt:(k+1)*nt] for k in range(RK)]), mtx_tmultinv[M[i,Piv[i]]]), None)
+                    M2.set_immutable()
+                    Autolift[Piv[i]] = [()] + [M2._mul_long(ff+1) for ff in range(fl-1)]
         Autolift['Piv'] = tuple(sorted(X for X in Piv if X<rknt))
         self.Autolift[d] = Autolift
         self.exportAction()
@@ -2574,7 +3399,7 @@ cdef class RESL:
             if (self.nRgs.ngs.r!=rk_1) or (self.nRgs.ngs.s != rk):
                 raise ArithmeticError("Theoretical error")
             # in coho.c: innerPreimages(nRgs, images->Data, s, resol->group, this->Data),
-            FfSetNoc(nt)
+            selectField(self.G_Alg.Data.p, nt)
             innerPreimages(self.nRgs, M.Data.Data, 1, self.G_Alg.Data, TMP.Data.Data)
             if check:
                 coho_logger.info("Checking the result", self)
@@ -2657,25 +3482,16 @@ cdef class RESL:
         coho_logger.debug('Compose chain maps R_%d -> R_%d -> R_%d', self, s,r,q)
         cdef MTX OUT
         OUT = new_mtx(MatAlloc(self.G_Alg.Data.p, self.Data.projrank[s]*self.Data.projrank[q],self.G_Alg.Data.nontips), M1)
-        cdef Matrix_t *L
-        cdef int i,j,k
         cdef int RK = self.Data.projrank[s]
         cdef int Rk = self.Data.projrank[r]
         cdef int rk = self.Data.projrank[q]
-        cdef long nontips = self.G_Alg.Data.nontips
-        FfSetNoc(nontips)
-        cdef PTR M2_ji = M2.Data.Data
+        selectField(self.G_Alg.Data.p, self.G_Alg.Data.nontips)
         # line ik of OUT is the sum of line ij of M1 times line jk of M2.
-        for j from 0 <= j < Rk:
-            for i from 0 <= i < rk:
-                L = leftActionMatrix(self.G_Alg.Data, M2_ji)
-                sig_check()
-                FfSetNoc(nontips)
-                for k from 0 <= k < RK:
-                    FfAddMapRow(FfGetPtr(M1.Data.Data,k*Rk+j), L.Data, nontips, FfGetPtr(OUT.Data.Data,k*rk+i))
-                    sig_check()
-                M2_ji += FfCurrentRowSize
-                MatFree(L)
+        sig_on()
+        try:
+            innerComposeChainMaps(self.G_Alg.Data, M1.Data.Data, M2.Data.Data, RK, Rk, rk, OUT.Data.Data)
+        finally:
+            sig_off()
         OUT.set_immutable()
         return OUT
 
@@ -2751,35 +3567,30 @@ cdef class RESL:
                 raise ValueError("Matrix representing a second chain map is of wrong size")
 
         cdef MTX IN1
-        cdef MTX OUT1
-        cdef Matrix_t *R
-        cdef int i,j,k,a
+        cdef int a
         cdef int RK = self.Data.projrank[s]
         cdef int Rk = self.Data.projrank[r]
-        cdef int loc_rk
         cdef int lenL2 = len(L2)
         cdef list rk = [self.Data.projrank[L2[a][1]] for a in range(len(L2))]
-        cdef long nontips = self.G_Alg.Data.nontips
-        cdef PTR IN1d, OUT1d, M1d
-        FfSetNoc(nontips)
+        selectField(self.G_Alg.Data.p, self.G_Alg.Data.nontips)
         # line ik of OUT[a] is the sum over j of line ij of M1 times line jk of L2[a][2].
         OUT = [[s, L2[a][1], new_mtx(MatAlloc(self.G_Alg.Data.p, self.Data.projrank[s]*rk[a],self.G_Alg.Data.nontips), M1)] for a in range(len(L2))]
-        M1d = M1.Data.Data
-        for k from 0 <= k < RK:
-            for j from 0 <= j < Rk:
-                R = rightActionMatrix(self.G_Alg.Data, M1d)
-                M1d += FfCurrentRowSize
-                for a from 0 <= a < lenL2:
-                    IN1 = L2[a][2]
-                    OUT1 = OUT[a][2]
-                    loc_rk = rk[a]
-                    IN1d = FfGetPtr(IN1.Data.Data,j*loc_rk)
-                    OUT1d = FfGetPtr(OUT1.Data.Data,k*loc_rk)
-                    for i from 0 <= i < loc_rk:
-                        FfAddMapRow(IN1d, R.Data, nontips, OUT1d)
-                        IN1d += FfCurrentRowSize
-                        OUT1d += FfCurrentRowSize
-                MatFree(R)
+        cdef PTR *beta = <PTR*>check_allocarray(lenL2, sizeof(PTR))
+        cdef PTR *gamma = <PTR*>check_allocarray(lenL2, sizeof(PTR))
+        cdef long *q = <long*>check_allocarray(lenL2, sizeof(long))
+        for a in range(lenL2):
+            IN1 = L2[a][2]
+            beta[a] = IN1.Data.Data
+            gamma[a] = (<MTX>OUT[a][2]).Data.Data
+            q[a] = rk[a]
+        sig_on()
+        try:
+            innerRightComposeMany(self.G_Alg.Data, M1.Data.Data, RK, Rk, lenL2, beta, q, gamma)
+        finally:
+            sig_off()
+            sig_free(beta)
+            sig_free(gamma)
+            sig_free(q)
         return OUT
 
     ################################################################
@@ -2872,7 +3683,7 @@ cdef class RESL:
         cdef MTX  TMP, DUMMY
         cdef list Z
         cdef int i,k
-        FfSetNoc(nt)
+        selectField(fl, nt)
         cdef tuple Piv = tuple(Autolift['Piv'])
         ##########################
         # Lift each "long row"
@@ -2975,6 +3786,189 @@ cdef class RESL:
         OUT.set_immutable()
         return OUT
 
+    def liftChainMaps(self, list L):
+        """
+        Lift a list of chain maps of the same degree at once.
+
+        INPUT:
+
+        ``L`` -- a list of triples ``(n,d,M)``, all with the same ``n`` and ``d``,
+        where ``M`` is a :class:`~sage.matrix.matrix_gfpn_dense.Matrix_gfpn_dense`
+        matrix representing a morphism from the `n`-th to the `d`-th term of self,
+        with `d<n`.
+
+        OUTPUT:
+
+        The list of the lifts ``(n+1,d+1,N)``, as they would be returned by
+        :meth:`liftChainMap`.
+
+        NOTE:
+
+        Unless the autolift method applies, all chain maps are lifted by a
+        single call to the Urbild Groebner basis of degree ``d+1``, and the
+        compositions with the differential are computed in one go.
+
+        EXAMPLES:
+
+        First, we create the basic data for the dihedral group of order 8
+        (compare :func:`~pGroupCohomology.resolution.makeGroupData`)::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL
+            sage: from sage.matrix.matrix_gfpn_dense import Matrix_gfpn_dense as MTX
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: R.nextDiff()
+            sage: L = [R.CochainToChainmap(2, MTX(MatrixSpace(GF(2),1,3, implementation=MTX), [v])) for v in [[1,0,1],[0,1,0],[1,1,1]]]
+            sage: Lifts = R.liftChainMaps(L)
+            sage: Lifts == [R.liftChainMap(c) for c in L]
+            True
+            sage: Lifts[0]
+            (
+                  [1 0 0 0 0 0 0 0]
+                  [0 0 0 0 0 0 0 0]
+                  [0 0 0 0 0 0 0 0]
+                  [0 0 0 0 0 0 0 0]
+                  [1 0 0 0 0 0 0 0]
+                  [0 0 0 1 0 0 0 0]
+                  [0 0 0 0 0 0 0 0]
+            3, 1, [1 0 0 0 0 0 0 0]
+            )
+
+        """
+        if not L:
+            return []
+        cdef int n,d
+        n = L[0][0]
+        d = L[0][1]
+        if (d>=n) or (d<0):
+            raise IndexError("Index out of range")
+        for X in L:
+            if X[0]!=n or X[1]!=d:
+                raise ValueError("All chain maps must be of the same degree and start at the same term")
+        if self.Autolift.get(d+1,{}):
+            return [self.liftChainMap(X) for X in L]
+        while (n>=len(self.Diff)):
+            self.nextDiff()
+        cdef list Compos = self.composeListOfMaps(self[n+1], n+1, [(X[0],X[1],X[2]) for X in L])
+        coho_logger.debug('Lift %d chain maps with Urbild Groebner basis in degree %d'%(len(L),d+1), self)
+        cdef long RK = self.Data.projrank[n+1]
+        cdef long rk = self.Data.projrank[d+1]
+        cdef long rk_1 = self.Data.projrank[d]
+        cdef long fl = self.G_Alg.Data.p
+        cdef long nt = self.G_Alg.Data.nontips
+        cdef long num = len(L)
+        cdef long a
+        cdef MTX C, N
+        cdef Matrix_t *images = NULL
+        cdef Matrix_t *preimages = NULL
+        self.load_ugb(d+1)
+        if (self.nRgs.ngs.r!=rk_1) or (self.nRgs.ngs.s != rk):
+            raise ArithmeticError("Theoretical error")
+        cdef list OUT = []
+        try:
+            sig_on()
+            try:
+                images = MatAlloc(fl, num*RK*rk_1, nt)
+                preimages = MatAlloc(fl, num*RK*rk, nt)
+            finally:
+                sig_off()
+            selectField(fl, nt)
+            for a in range(num):
+                C = Compos[a][2]
+                memcpy(MatGetPtr(images, a*RK*rk_1), C.Data.Data, FfCurrentRowSize*RK*rk_1)
+            sig_on()
+            try:
+                innerPreimages(self.nRgs, images.Data, num*RK, self.G_Alg.Data, preimages.Data)
+            finally:
+                sig_off()
+            for a in range(num):
+                N = new_mtx(MatAlloc(fl, RK*rk, nt), L[a][2])
+                memcpy(N.Data.Data, MatGetPtr(preimages, a*RK*rk), FfCurrentRowSize*RK*rk)
+                N.set_immutable()
+                OUT.append((n+1,d+1,N))
+        finally:
+            if images != NULL:
+                MatFree(images)
+            if preimages != NULL:
+                MatFree(preimages)
+        return OUT
+
+    def liftCochains(self, list L, int n):
+        """
+        Make sure that the lifts of a list of cochains out to degree `n` are known.
+
+        INPUT:
+
+        - ``L`` -- a list of :class:`~pGroupCohomology.cochain.COCH`, defined over self.
+        - ``n`` -- an integer.
+
+        NOTE:
+
+        The lifts are stored in the same way as in a cup product, so that a
+        subsequent product of a cochain of degree `n-d` with a cochain of degree
+        `d` in ``L`` will use them. Chain maps of the same degree that are
+        known out to the same degree are lifted together by :meth:`liftChainMaps`.
+
+        EXAMPLES::
+
+            sage: from pGroupCohomology import CohomologyRing
+            sage: CohomologyRing.doctest_setup()       # reset, block web access, use temporary workspace
+            sage: H = CohomologyRing(8,3, from_scratch=True)
+            sage: R = H.resolution()
+            sage: from pGroupCohomology.cochain import COCH
+            sage: for i in range(4):
+            ....:     R.nextDiff()
+            sage: C1 = COCH(H,2,'C1',[1,0,1])
+            sage: C2 = COCH(H,2,'C2',[0,1,1])
+            sage: R.liftCochains([C1,C2], 4)
+            sage: sorted(R.getLifts().keys())
+            [(2, 2), (3, 2), (4, 2)]
+            sage: X = R.liftChainMap(R.liftChainMap(R.CochainToChainmap(2,C2.MTX())))
+            sage: R.getLifts()[(4,2)][C2.MTX()][0] == X
+            True
+
+        """
+        cdef COCH C
+        cdef list Pending = []
+        cdef int m, Cdeg
+        for X in L:
+            if not isinstance(X, COCH):
+                continue
+            C = X
+            Cdeg = C.deg()
+            if Cdeg == 0 or Cdeg > n:
+                continue
+            CM = C.MTX()
+            if self.Lifts[(n,Cdeg,CM)] is not None:
+                continue
+            TryLift = None
+            for m from n > m >= Cdeg:
+                TryLift = self.Lifts[(m,Cdeg,CM)]
+                if TryLift is not None:
+                    break
+            if TryLift is None:
+                self.setLift(C, 2*Cdeg)
+                TryLift = (self.CochainToChainmap(Cdeg,CM), 2*Cdeg)
+            Pending.append((Cdeg, CM, TryLift))
+        cdef dict Groups
+        while Pending:
+            Groups = {}
+            for X in Pending:
+                Groups.setdefault(X[2][0][:2], []).append(X)
+            Pending = []
+            for Group in Groups.values():
+                Lifts = self.liftChainMaps([X[2][0] for X in Group])
+                for X, Y in zip(Group, Lifts):
+                    self.Lifts[(Y[0],X[0],X[1])] = (Y, X[2][1])
+                    if Y[0] < n:
+                        Pending.append((X[0], X[1], (Y, X[2][1])))
+
     #############################################
     # Yoneda complex
 
@@ -3156,6 +4150,16 @@ cdef class RESL:
 #####################################################################
 #####################################################################
 
+cdef long lift_bytes(v):
+    """
+    Memory used by the matrices of an entry of a :class:`LIFTcontainer`.
+    """
+    if isinstance(v, MTX):
+        return (<MTX>v).Data.Nor * (<MTX>v).Data.RowSize if (<MTX>v).Data != NULL else 0
+    if isinstance(v, (tuple, list)):
+        return sum([lift_bytes(w) for w in v])
+    return 0
+
 cdef class LIFTcontainer:
     """
     An extension class whose purpose is to cache the lifts of chain maps of a resolution to itself.
@@ -3256,6 +4260,17 @@ cdef class LIFTcontainer:
         tmp=R
         self.Parent = R
         self.Data = {}
+        self.limit = 0
+        self.policy = 'lru'
+        self.Use = {}
+        self.Size = {}
+        self.Files = {}
+        self.Dirty = set()
+        self.clock = 0
+        self.nbytes = 0
+        self.hits = 0
+        self.misses = 0
+        self.evictions = 0
 
     def out(self):
         """
@@ -3392,7 +4407,16 @@ cdef class LIFTcontainer:
             except (OSError, IOError), msg:
                 pass
             self.Data[(n,d)] = D
-        return self.Data.get((n,d),{}).get(key[2],None)
+            self.Files[(n,d)] = s
+            self.touch((n,d), sum([lift_bytes(v) for v in D.values()]))
+        elif (n,d) in self.Data:
+            self.touch((n,d), 0)
+        OUT = self.Data.get((n,d),{}).get(key[2],None)
+        if OUT is None:
+            self.misses += 1
+        else:
+            self.hits += 1
+        return OUT
 
     def __setitem__(self,key,v):
         """
@@ -3481,7 +4505,14 @@ cdef class LIFTcontainer:
             except Exception, msg:
                 pass
             self.Data[(n,d)] = D
+            self.Files[(n,d)] = s
+            delta = sum([lift_bytes(w) for w in D.values()])
+        else:
+            delta = 0
+        delta += lift_bytes(v) - lift_bytes(self.Data[(n,d)].get(key[2],None))
         self.Data[(n,d)][key[2]] = v
+        self.Dirty.add((n,d))
+        self.touch((n,d), delta)
 
     def __delitem__(self,key):
         """
@@ -3566,8 +4597,14 @@ cdef class LIFTcontainer:
                     D.update(load(s+'.sobj'))  # realpath here?
             except Exception, msg:
                 raise msg
-        D.pop(key[2],None)
+            self.Files[(n,d)] = s
+            delta = sum([lift_bytes(w) for w in D.values()])
+        else:
+            delta = 0
+        delta -= lift_bytes(D.pop(key[2],None))
         self.Data[(n,d)]=D
+        self.Dirty.add((n,d))
+        self.touch((n,d), delta)
 
     def parent(self):
         """
@@ -3663,35 +4700,216 @@ cdef class LIFTcontainer:
             True
 
         """
-        cdef dict D
+        for X in list(self.Data.keys()):
+            self.export_group(X)
+
+    def export_group(self, tuple X):
+        """
+        Store the cached lifts ``(n,d)=X`` on disk, and keep only the file name in memory.
+
+        EXAMPLES::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL, LIFTcontainer
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: L = LIFTcontainer(R)
+            sage: L[1,2,3] = 4
+            sage: L[2,2,3] = 5
+            sage: L.export_group((1,2))
+            sage: sorted(L.out().items())
+            [((1, 2), {'file': '.../8gp3/dat/L8gp3n1d2'}), ((2, 2), {3: 5})]
+            sage: L[1,2,3]
+            4
+
+        Lifts that did not change since they were loaded are not stored again::
+
+            sage: fname = os.path.join(res_folder, 'L8gp3n1d2.sobj')
+            sage: os.utime(fname, (0, 0))
+            sage: L.export_group((1,2))
+            sage: os.path.getmtime(fname)
+            0.0
+            sage: L[1,2,4] = 5
+            sage: L.export_group((1,2))
+            sage: sorted(load(fname))
+            [(3, 4), (4, 5)]
+
+        """
+        cdef dict D = self.Data[X]
         import os
-        for X,D in self.Data.items():
-            s = D.pop('file','')
-            if (not s) and isinstance(D.get(1,None), tuple):
-                # Problem: the number 1 evaluates equal to
-                # the MTX matrix [1]. That hasn't been the
-                # case in the past. Now we have to deal with
-                # it, since in old data it is assumed that
-                # they aren't equal.
-                s = ''
-            else: # That's old exported data
-                s = D.pop(1,'')
-            if s:
-                if len(D)>1:
-                    if s.endswith('.sobj'):
-                        D.update(load(s))  # realpath here?
-                    else:
-                        D.update(load(s+'.sobj'))  # realpath here?
-                    try:
-                        del D['file']
-                    except KeyError:
-                        coho_logger.debug("updating old data", self.Parent)
-                        del D[1]
-                    safe_save(list(D.items()),s)
-                    D = {'file':s}
+        s = D.pop('file','')
+        if (not s) and isinstance(D.get(1,None), tuple):
+            # Problem: the number 1 evaluates equal to
+            # the MTX matrix [1]. That hasn't been the
+            # case in the past. Now we have to deal with
+            # it, since in old data it is assumed that
+            # they aren't equal.
+            s = ''
+        else: # That's old exported data
+            s = D.pop(1,'')
+        if s:
+            # Lifts that were added since the file was loaded are merged
+            # into the file; in any case, only the file name is kept
+            if D:
+                if s.endswith('.sobj'):
+                    D.update(load(s))  # realpath here?
+                else:
+                    D.update(load(s+'.sobj'))  # realpath here?
+                try:
+                    del D['file']
+                except KeyError:
+                    coho_logger.debug("updating old data", self.Parent)
+                    D.pop(1,None)
+                safe_save(list(D.items()),s)
+            self.Data[X] = {'file':s}
+        elif X in self.Files and X not in self.Dirty:
+            # The lifts did not change since they were loaded from the file
+            self.Data[X] = {'file':self.Files[X]}
+        else:
+            s = self.Files.get(X) or os.path.join(self.Parent.res_folder,'L'+self.Parent.gstem+'n'+str(X[0])+'d'+str(X[1]))
+            safe_save(list(D.items()),s)
+            self.Data[X] = {'file':s}
+        self.Files[X] = self.Data[X]['file']
+        self.Dirty.discard(X)
+        self.nbytes -= self.Size.pop(X, 0)
+
+    cdef touch(self, tuple X, long delta):
+        """
+        Record an access to the lifts ``X``, whose memory has grown by ``delta``.
+        """
+        self.clock += 1
+        self.Use[X] = self.clock
+        if delta:
+            self.Size[X] = self.Size.get(X, 0) + delta
+            self.nbytes += delta
+        if self.limit and self.nbytes > self.limit:
+            self.evict(X)
+
+    cdef evict(self, tuple keep):
+        """
+        Store lifts on disk until the memory limit is met.
+
+        The lifts ``keep`` are kept in memory. With the policy ``'lru'``,
+        the least recently used lifts are evicted first. With the policy
+        ``'degree'``, lifts to the lowest term of the resolution go first,
+        since their degree has already been dealt with.
+        """
+        cdef list Candidates
+        while self.nbytes > self.limit:
+            if self.policy == 'degree':
+                Candidates = [((Y[0], self.Use.get(Y, 0)), Y) for Y,b in self.Size.items() if b > 0 and Y != keep]
             else:
-                safe_save(list(D.items()),os.path.join(self.Parent.res_folder,'L'+self.Parent.gstem+'n'+str(X[0])+'d'+str(X[1])))
-                self.Data[X] = {'file':os.path.join(self.Parent.res_folder,'L'+self.Parent.gstem+'n'+str(X[0])+'d'+str(X[1]))}
+                Candidates = [(self.Use.get(Y, 0), Y) for Y,b in self.Size.items() if b > 0 and Y != keep]
+            if not Candidates:
+                return
+            X = min(Candidates)[1]
+            coho_logger.debug("Evicting lifts %r from memory", self.Parent, X)
+            self.export_group(X)
+            self.evictions += 1
+
+    def set_limit(self, long nbytes, policy='lru'):
+        """
+        Bound the memory used by the lifts that are kept in memory.
+
+        INPUT:
+
+        - ``nbytes`` -- the number of bytes of lifts that may be kept in
+          memory, or zero for no limit.
+        - ``policy`` (optional string, default ``'lru'``) -- either ``'lru'``
+          or ``'degree'``, determining which lifts are stored on disk first
+          when the limit is exceeded. Stored lifts are reloaded on demand.
+
+        EXAMPLES::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL, LIFTcontainer
+            sage: from sage.matrix.matrix_gfpn_dense import Matrix_gfpn_dense as MTX
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: L = LIFTcontainer(R)
+            sage: L.set_limit(1, 'degree')
+            sage: L[2,1,5] = MTX(MatrixSpace(GF(2),2,8, implementation=MTX))
+            sage: L[3,1,5] = MTX(MatrixSpace(GF(2),2,8, implementation=MTX))
+
+        The limit is exceeded, so, the lifts to the lower term were stored::
+
+            sage: L.out()[(2,1)]
+            {'file': '.../8gp3/dat/L8gp3n2d1'}
+            sage: list(L.out()[(3,1)])
+            [5]
+            sage: L[2,1,5]
+            [0 0 0 0 0 0 0 0]
+            [0 0 0 0 0 0 0 0]
+            sage: list(L.out()[(2,1)])
+            [5]
+            sage: L.out()[(3,1)]
+            {'file': '.../8gp3/dat/L8gp3n3d1'}
+            sage: L.statistics()['evictions']
+            2
+            sage: L.set_limit(0, 'foo')
+            Traceback (most recent call last):
+            ...
+            ValueError: The eviction policy must be 'lru' or 'degree'
+
+        """
+        if policy not in ('lru', 'degree'):
+            raise ValueError("The eviction policy must be 'lru' or 'degree'")
+        self.limit = max(nbytes, 0)
+        self.policy = policy
+        if self.limit and self.nbytes > self.limit:
+            self.evict(())
+
+    def limits(self):
+        """
+        Return the memory limit in bytes and the eviction policy.
+
+        EXAMPLES::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL, LIFTcontainer
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: L = LIFTcontainer(R)
+            sage: L.limits()
+            (0, 'lru')
+            sage: L.set_limit(1000, 'degree')
+            sage: L.limits()
+            (1000, 'degree')
+
+        """
+        return (self.limit, self.policy)
+
+    def statistics(self):
+        """
+        Return the number of bytes in memory, hits, misses and evictions.
+
+        EXAMPLES::
+
+            sage: tmp_root = tmp_dir()
+            sage: from pGroupCohomology.resolution import makeGroupData, RESL, LIFTcontainer
+            sage: makeGroupData(8,3,folder=tmp_root)
+            sage: gstem='8gp3'
+            sage: gps_folder=os.path.join(tmp_root,gstem)
+            sage: res_folder=os.path.join(gps_folder,'dat')
+            sage: R=RESL(gstem,gps_folder,res_folder)
+            sage: L = LIFTcontainer(R)
+            sage: L[1,2,3] = 4
+            sage: L[1,2,3], L[1,2,4]
+            (4, None)
+            sage: sorted(L.statistics().items())
+            [('bytes', 0), ('evictions', 0), ('hits', 1), ('misses', 1)]
+
+        """
+        return {'bytes': self.nbytes, 'hits': self.hits, 'misses': self.misses, 'evictions': self.evictions}
 
 #####################################################################
 #####################################################################
@@ -3781,6 +4999,14 @@ cdef class G_ALG:
             sage: G
             GF(2)[8gp3]
 
+        The group data are read from the text files only once. A binary
+        snapshot of them is stored and used for the next construction::
+
+            sage: os.path.exists(os.path.join(gps_folder, gstem+'.snap'))
+            True
+            sage: G_ALG(gstem,folder=gps_folder,dependent=False)
+            GF(2)[8gp3]
+
         """
         if folder is None:
             folder = ''
@@ -4138,10 +5364,8 @@ cdef class G_ALG:
 
         cdef MTX OUT
         OUT = new_mtx(MatAlloc(self.Data.p, s,self.Data.nontips), M)
-        cdef PTR scratch
-        scratch = FfAlloc(self.Data.nontips+1)
-        innerRightCompose(self.Data, x.Data.Data, M.Data.Data, 1,r,s, scratch, OUT.Data.Data)
-        sig_free(scratch)
+        selectField(self.Data.p, self.Data.nontips)
+        innerRightCompose(self.Data, x.Data.Data, M.Data.Data, 1,r,s, OUT.Data.Data)
         OUT.set_immutable()
         return OUT
 
@@ -27,6 +27,12 @@ cdef extern from "modular_resolution/pgroup.h":
         long lastArrow
         long depth       #/* depth of node in tree, i.e. length of path */
         long dim         # /* Dimension of path, for Jennings case */
+    ctypedef struct fieldContext_t:
+        long fl
+        long noc
+        size_t rowSize
+        size_t rowSizeIo
+    void selectField(long fl, long noc)
     ctypedef struct group_t:
         char *stem
         long arrows
@@ -43,6 +49,10 @@ cdef extern from "modular_resolution/pgroup.h":
         Matrix_t **bch
         long *dim
         long *dS          # /* depth Steps: for resolution only */
+        PTR *rcache
+        PTR *lcache
+        long cacheLimit, cacheBytes, cacheHits, cacheMisses
+        fieldContext_t fc
 
 ###############################################################
 ## function prototypes for p-groups
@@ -59,14 +69,27 @@ cdef extern from "modular_resolution/pgroup_decls.h":
     path_t *allocatePathTree(group_t *group) except NULL
     int buildPathTree(group_t *group) except 1
     int buildLeftPathTree(group_t *group) except 1
+    int buildGroupRecord(group_t *group, long *perm, long threads) except 1
+    int saveNonTips(group_t *group) except 1
+    int saveActionMatrices(group_t *group) except 1
+    int saveLeftActionMatrices(group_t *group) except 1
+    int saveBasisChangeMatrices(group_t *group) except 1
+    int saveGroupSnapshot(group_t *group)
 
     Matrix_t *rightActionMatrix(group_t *group, PTR vec)
     Matrix_t *leftActionMatrix(group_t *group, PTR vec)
     void FfAddMapRow(PTR row, PTR matrix, int nor, PTR result)
     void innerRightActionMatrix(group_t *group, PTR vec, PTR dest)
     void innerLeftActionMatrix(group_t *group, PTR vec, PTR dest)
-    void innerRightCompose(group_t *group, PTR alpha, PTR beta, \
-                                long s, long r, long q, PTR scratch, PTR gamma)
+    int enableActionMatrixCache(group_t *group, long bytes) except 1
+    void disableActionMatrixCache(group_t *group)
+    void actionMatrixCacheStatistics(group_t *group, long *bytes, long *hits, long *misses)
+    int innerRightCompose(group_t *group, PTR alpha, PTR beta, \
+                                long s, long r, long q, PTR gamma) except 1
+    int innerRightComposeMany(group_t *group, PTR alpha, long s, long r, long n, \
+                                PTR *beta, long *q, PTR *gamma) except 1
+    int innerComposeChainMaps(group_t *group, PTR M1, PTR M2, long RK, long Rk, \
+                                long rk, PTR out) except 1
 
     int verifyGroupIsAbelian(group_t *A) except? -1
 
@@ -91,6 +114,8 @@ cdef extern from "modular_resolution/modular_resolution.h":
     # /* Represents urbild Groebner basis for d_n : P_n -> P_{n-1} */
 
     cdef nRgs_t *nRgsStandardSetup(resol_t *resol, long n, PTR mat) except NULL
+    cdef char *checkpointFile(resol_t *resol, long n)
+    cdef nRgs_t *nRgsCheckpointSetup(resol_t *resol, long n, char *file) except NULL
     # /* mat should be a block of length rankProj(resol, n-1) x rankProj(resol, n) */
 
     cdef resol_t *newResolWithGroupLoaded (char *RStem, char *GStem, long N) except NULL
@@ -132,10 +157,23 @@ cdef extern from "modular_resolution/nDiag.h":
 
     ctypedef struct modW_t:
         modW_t *parent
-        modW_t **child
         rV_t *divisor
-        long qi   #  /* index of quotient path */
-        long status
+
+    ctypedef struct wordState_t:
+        int status
+        int qi    #  /* index of quotient path */
+
+    ctypedef struct bStat_t: # buchbergerStatistics
+        long expansions
+        double expandTime
+        long products
+        double productTime
+        long blockReads, blockBytes
+        double readTime
+        long reductions
+        double reduceTime
+        long promotions, demotions
+        long unfruitful, overshoot
 
     ctypedef struct ngs_t: # newCommonGeneratingSet
         long r, s # /* r is rank of ambient free, s rank of preimage (0 for fgs) */
@@ -143,7 +181,7 @@ cdef extern from "modular_resolution/nDiag.h":
         rV_t *lastReduced
         uV_t *unreducedHeap
         modW_t **proot
-        gV_t *gVwaiting
+        wordState_t *wstate
         long pnontips # /* present guess at the number of nontips */
         long expDim
         long targetRank
@@ -158,6 +196,10 @@ cdef extern from "modular_resolution/nDiag.h":
         # char stem[MAXLINE]
         char stem[120]
         long prev_pnon, unfruitful
+        long threads
+        size_t sliceMemory, sliceBytes
+        long cacheSize, cacheHits, cacheMisses
+        bStat_t stats
 
     ctypedef struct nFgs_t: # newFlaggedGeneratingSet
         boolean finished
@@ -171,10 +213,31 @@ cdef extern from "modular_resolution/nDiag.h":
         long prev_ker_pnon, overshoot
 
 
+#####################################################################
+## autolift data
+cdef extern from "modular_resolution/autolift_decls.h":
+    Matrix_t *autoliftPreimages(Matrix_t **DG, long nt, long rk, long RK, long threads, long *pivots, long *npiv) except NULL
+
+#####################################################################
+## stored matrices
+cdef extern from "modular_resolution/fp_decls.h":
+    long numberOfRowsStored(char *name)
+    Matrix_t *mappedMatLoad(char *name) except NULL
+    int sparseMatSave(Matrix_t *mat, char *name) except 1
+    int sparsifyMatrixFile(char *name) except 1
+    int compressedMatSave(Matrix_t *mat, char *name, long blockRows) except 1
+    int compressMatrixFile(char *name, long blockRows) except 1
+
 #####################################################################
 ## preimages / "urbild Groebner basis"
 cdef extern from "modular_resolution/urbild_decls.h":
     void freeNRgs(nRgs_t *nRgs)
+    void nRgsSetThreads(nRgs_t *nRgs, long threads)
+    void nRgsSetSliceMemory(nRgs_t *nRgs, long bytes)
+    int nRgsSetBlockCache(nRgs_t *nRgs, long blocks) except 1
+    void nRgsSetCheckpoint(nRgs_t *nRgs, char *file, double seconds)
+    void nRgsSetCompression(nRgs_t *nRgs, boolean compress)
+    void nRgsSetTiming(nRgs_t *nRgs, boolean timing)
     int saveUrbildGroebnerBasis(nRgs_t *nRgs, char *outfile, group_t *group) except 1
     #long countGenerators(nFgs_t *nFgs)
     long numberOfHeadyVectors(ngs_t *ngs)
@@ -43,22 +43,22 @@ ext_mods = [
     Extension("pGroupCohomology.resolution",
               sources = [os.path.join("pGroupCohomology","resolution.pyx")],
               include_dirs = sage_include_directories(),
-              libraries = ['mtx', 'modres']),
+              libraries = ['mtx', 'modres', 'z']),
 
     Extension("pGroupCohomology.cochain",
               sources = [os.path.join("pGroupCohomology","cochain.pyx")],
               include_dirs = sage_include_directories(),
-              libraries = ['mtx', 'modres']),
+              libraries = ['mtx', 'modres', 'z']),
 
     Extension("pGroupCohomology.cohomology",
               sources = [os.path.join("pGroupCohomology","cohomology.pyx")],
               include_dirs = sage_include_directories(),
-              libraries = ['mtx', 'modres']),
+              libraries = ['mtx', 'modres', 'z']),
 
     Extension("pGroupCohomology.modular_cohomology",
               sources = [os.path.join("pGroupCohomology","modular_cohomology.pyx")],
               include_dirs = sage_include_directories(),
-              libraries = ['mtx', 'modres']),
+              libraries = ['mtx', 'modres', 'z']),
 
     Extension("pGroupCohomology.dickson",
               sources = [os.path.join("pGroupCohomology","dickson.pyx")],
@@ -93,7 +93,7 @@ setup(
   description = "Modular Cohomology Rings of Finite Groups",
   packages = find_packages(),
   package_data={'pGroupCohomology': ['*.pxd']},
-  py_modules = ["pGroupCohomology.auxiliaries", "pGroupCohomology.barcode", "pGroupCohomology.factory", "pGroupCohomology.isomorphism_test"],
+  py_modules = ["pGroupCohomology.auxiliaries", "pGroupCohomology.barcode", "pGroupCohomology.factory", "pGroupCohomology.isomorphism_test", "pGroupCohomology.benchmarks"],
   data_files=[(os.path.join(SAGE_SHARE,"sage","ext","gap","modular_cohomology"),
               [os.path.join("pGroupCohomology","GapMaxels.g"),
                os.path.join("pGroupCohomology","GapMB.g"),